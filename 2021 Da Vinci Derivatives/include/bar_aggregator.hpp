@@ -0,0 +1,102 @@
+#pragma once
+
+#include <book_builder.hpp>
+#include <flat_hash_map.hpp>
+#include <record_columns.hpp>
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Bars of one symbol, one row per time bucket which had records of the symbol.
+// Order flow is the volume of inserted and amended orders.
+struct BarColumns
+{
+    static constexpr Price NO_PRICE = std::numeric_limits<Price>::min();
+
+    std::vector<Timestamp> start;
+
+    std::vector<uint64_t> buyVolume;
+    std::vector<uint64_t> sellVolume;
+    std::vector<uint64_t> cancelVolume;
+    // Sum of price * volume of the order flow.
+    std::vector<int64_t> notional;
+
+    // Best price after every record of the bar, NO_PRICE while the side is empty.
+    std::vector<Price> bidOpen;
+    std::vector<Price> bidHigh;
+    std::vector<Price> bidLow;
+    std::vector<Price> bidClose;
+    std::vector<Price> askOpen;
+    std::vector<Price> askHigh;
+    std::vector<Price> askLow;
+    std::vector<Price> askClose;
+
+    // Order flow volume by price, profile of bar i is [profileOffset[i], profileOffset[i + 1])
+    // in order of the first appearance of the price in the bar.
+    std::vector<uint32_t> profileOffset = {0};
+    std::vector<Price> profilePrice;
+    std::vector<uint64_t> profileVolume;
+
+    size_t size() const;
+
+    // Volume weighted average price of the order flow (in Price units), 0 if there was none.
+    double vwap(size_t bar) const;
+};
+
+
+// Aggregates records into per-symbol bars of a fixed width in a single pass.
+// Records of every symbol must come sorted by timestamp.
+class BarAggregator final
+{
+public:
+    explicit BarAggregator(Timestamp width);
+
+    void add(const Record& record);
+    void add(const RecordColumns& columns);
+
+    Timestamp width() const;
+
+    // Symbols in ascending order.
+    std::vector<Symbol> symbols() const;
+
+    // Bars of the symbol, empty for an unknown symbol. The last bar is still open.
+    const BarColumns& bars(const Symbol& symbol) const;
+
+    // One line per bar, the profile is a space separated list of "price:volume".
+    void writeCsv(std::ostream& stream) const;
+    void writeCsv(const std::string& filename) const;
+
+    // Raw columns of every symbol, read back with barsFromFile.
+    void writeBinary(const std::string& filename) const;
+
+private:
+    struct SymbolBars
+    {
+        BarColumns columns;
+        FlatHashMap<Price, uint32_t> profileIndex;
+    };
+
+    void openBar(SymbolBars& data, Timestamp start);
+    void updateProfile(SymbolBars& data, Price price, Volume volume);
+
+private:
+    Timestamp width_;
+    BookBuilder book_;
+    FlatHashMap<Symbol, SymbolBars> bars_;
+};
+
+
+struct BarFile
+{
+    Timestamp width;
+    std::vector<std::pair<Symbol, BarColumns>> symbols;
+};
+
+BarFile barsFromFile(const std::string& filename);
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <flat_hash_map.hpp>
+#include <record_columns.hpp>
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <vector>
+
+
+// Reconstructs full limit order books (both sides, every symbol) from records.
+// Amend is handled as cancel plus insert, so an amended order loses its place
+// in the queue, the same way BuyOrderFinder treats amends.
+//
+// Price levels of every side near its best price live in a fixed window of
+// a flat ladder indexed by price, levels outside of the window are kept in
+// a sparse map, so an outlier price costs one map node instead of a ladder
+// stretched up to it. The window is re-centred when the best price leaves it,
+// or on new orders once many of them miss it (e.g. the best order is stale and
+// the market moved away), the best level does not have to be in the window.
+// Orders are nodes of one pool linked into per-level FIFO queues.
+class BookBuilder final
+{
+public:
+    struct Level
+    {
+        Price price;
+        Volume volume;
+        uint32_t orders;
+    };
+
+    struct Order
+    {
+        OrderID orderID;
+        Volume volume;
+        Timestamp ts;
+    };
+
+    struct OrderLevel
+    {
+        Price price;
+        Volume volume;
+        std::vector<Order> orders;
+    };
+
+    // Aggregated levels, best first.
+    struct L2Snapshot
+    {
+        std::vector<Level> bids;
+        std::vector<Level> asks;
+    };
+
+    // Levels with their orders in queue order, best first.
+    struct L3Snapshot
+    {
+        std::vector<OrderLevel> bids;
+        std::vector<OrderLevel> asks;
+    };
+
+    static constexpr size_t FULL_DEPTH = std::numeric_limits<size_t>::max();
+
+public:
+    BookBuilder() = default;
+
+    void add(const Record& record);
+    void add(const RecordColumns& columns);
+
+    std::optional<Level> bestBid(const Symbol& symbol) const;
+    std::optional<Level> bestAsk(const Symbol& symbol) const;
+
+    L2Snapshot l2(const Symbol& symbol, size_t depth = FULL_DEPTH) const;
+    L3Snapshot l3(const Symbol& symbol, size_t depth = FULL_DEPTH) const;
+
+    size_t numberOfOrders(const Symbol& symbol) const;
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Node
+    {
+        OrderID orderID;
+        Volume volume;
+        Timestamp ts;
+        Price price;
+        Side side;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    struct LevelData
+    {
+        Volume volume = 0;
+        uint32_t orders = 0;
+        uint32_t head = NONE;
+        uint32_t tail = NONE;
+    };
+
+    // Levels of one side, levels[i] keeps price base + i,
+    // outside keeps non-empty levels with prices out of the window.
+    struct Ladder
+    {
+        int64_t base = 0;
+        std::vector<LevelData> levels;
+        std::map<Price, LevelData> outside;
+        std::optional<Price> best;
+        size_t windowLevels = 0;
+        // orders inserted out of the window since it was moved
+        uint32_t misses = 0;
+    };
+
+    struct SymbolBook
+    {
+        Ladder bids;
+        Ladder asks;
+        FlatHashMap<OrderID, uint32_t> orders;
+    };
+
+    uint32_t addOrder(SymbolBook& book, const Record& record);
+    void requeueNode(SymbolBook& book, uint32_t node, const Record& record);
+    void unlinkNode(SymbolBook& book, uint32_t node);
+
+    uint32_t allocateNode();
+    void releaseNode(uint32_t index);
+
+    static std::optional<Level> bestLevel(const Ladder& ladder);
+    static bool better(Side side, Price a, Price b);
+    static bool inWindow(const Ladder& ladder, Price price);
+    static LevelData& levelOf(Ladder& ladder, Price price);
+    static void releaseLevel(Ladder& ladder, Price price);
+    static void recentre(Ladder& ladder, Price price);
+    static void findNextBest(Ladder& ladder, Side side, Price previousBest);
+
+    template <typename Callback>
+    static void forEachLevel(const Ladder& ladder, Side side, size_t depth, Callback&& callback);
+
+private:
+    FlatHashMap<Symbol, SymbolBook> books_;
+    std::vector<Node> nodes_;
+    uint32_t freeNodes_ = NONE;
+};
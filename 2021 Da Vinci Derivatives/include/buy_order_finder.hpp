@@ -1,10 +1,9 @@
 #pragma once
 
+#include <record_columns.hpp>
+#include <top_k_finder.hpp>
 #include <types.hpp>
 
-#include <functional>
-#include <set>
-#include <unordered_map>
 #include <vector>
 
 
@@ -23,22 +22,13 @@ public:
     };
 
 public:
-    BuyOrderFinder() = default;
+    BuyOrderFinder();
 
     void add(const Record& record);
+    void add(const RecordColumns& columns);
 
     std::vector<BuyOrder> biggestBuyOrders(const Symbol& symbol) const;
 
 private:
-    void addOrder(const Record& record);
-    void removeOrder(const Record& record);
-
-private:
-    struct BuyOrdersData
-    {
-        std::unordered_map<OrderID, std::multiset<BuyOrder>::iterator> activeOrders;
-        std::multiset<BuyOrder, std::greater<BuyOrder>> sortedOrders;
-    };
-
-    std::unordered_map<Symbol, BuyOrdersData> buyOrders_;
+    TopKFinder<Side::BUY, VolumeKey> finder_;
 };
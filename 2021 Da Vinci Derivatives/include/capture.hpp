@@ -0,0 +1,93 @@
+#pragma once
+
+#include <record_filter.hpp>
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+struct CaptureBlock
+{
+    uint64_t offset;
+    uint32_t records;
+    Timestamp minTs;
+    Timestamp maxTs;
+};
+
+
+// Binary capture of a record stream.
+//
+// The file is a sequence of blocks followed by a block index. Every block
+// holds up to blockSize records in columnar layout: a symbol dictionary,
+// then timestamps, symbol codes, order IDs, volumes, prices (all as varints,
+// timestamps, order IDs and prices delta-encoded) and one byte of operation
+// and side per record. The index keeps offset, number of records and min/max
+// timestamp of every block, so readers can skip blocks outside a time range.
+class CaptureWriter final
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
+
+public:
+    explicit CaptureWriter(const std::string& filename, size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    void add(const Record& record);
+
+    // Flushes the last block and writes the block index, no records can be added after.
+    void finish();
+
+private:
+    void writeBlock();
+
+private:
+    std::ofstream output_;
+    size_t blockSize_;
+    std::vector<Record> block_;
+    std::vector<CaptureBlock> index_;
+    bool finished_ = false;
+};
+
+
+class CaptureReader final
+{
+public:
+    explicit CaptureReader(const std::string& filename);
+
+    const std::vector<CaptureBlock>& blocks() const;
+    size_t size() const;
+
+    std::vector<Record> read();
+
+    // Reads only records with from <= ts <= to, blocks outside the range aren't decoded.
+    std::vector<Record> read(Timestamp from, Timestamp to);
+
+    // Reads only records matching the filter, blocks outside its time window aren't decoded.
+    std::vector<Record> read(const RecordFilter& filter);
+
+private:
+    void readBlock(const CaptureBlock& block, std::vector<Record>& records);
+
+private:
+    std::ifstream input_;
+    std::vector<CaptureBlock> index_;
+    // offset of the block index, all blocks end before it
+    uint64_t dataEnd_ = 0;
+    std::vector<char> buffer_;
+};
+
+
+void recordsToCapture(const std::vector<Record>& records, const std::string& filename);
+
+std::vector<Record> recordsFromCapture(const std::string& filename);
+
+std::vector<Record> recordsFromCapture(const std::string& filename, Timestamp from, Timestamp to);
+
+std::vector<Record> recordsFromCapture(const std::string& filename, const RecordFilter& filter);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+
+// Thrown by FeedFollower::poll() for a line which is not a record,
+// other errors (e.g. I/O) are reported by std::runtime_error.
+class MalformedLineError final : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+
+// Follows an append-only data file, like `tail -f`.
+// Only complete (newline terminated) lines are parsed, an incomplete last line
+// is read again until the rest of it is appended. A malformed line is reported
+// by MalformedLineError from poll() and skipped, the next poll() continues after it.
+// If the file shrinks, it is considered to be rewritten and is read again from
+// the beginning.
+// On Linux waiting for new data is done with inotify, elsewhere by sleeping.
+class FeedFollower final
+{
+public:
+    using Callback = std::function<void(const Record&)>;
+
+public:
+    explicit FeedFollower(const std::string& filename);
+    ~FeedFollower();
+
+    FeedFollower(const FeedFollower&) = delete;
+    FeedFollower& operator=(const FeedFollower&) = delete;
+
+    // Parses all complete lines appended since the last call, returns their number.
+    // Records parsed before a malformed line are passed to the callback before the error is thrown.
+    size_t poll(const Callback& callback);
+
+    // Blocks until the file is modified or timeout expires.
+    // Returns false on timeout, may return true spuriously.
+    bool wait(std::chrono::milliseconds timeout);
+
+private:
+    std::string filename_;
+    std::ifstream input_;
+    // position after the last consumed line
+    uint64_t offset_ = 0;
+    std::string partialLine_;
+    std::string buffer_;
+    int notifyFd_ = -1;
+};
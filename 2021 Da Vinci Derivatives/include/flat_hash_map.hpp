@@ -0,0 +1,377 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// Multiplicative (Fibonacci) hash for integer keys, tables use its highest bits.
+template <typename Key>
+struct FlatHash
+{
+    static_assert(std::is_integral_v<Key>, "FlatHash supports only integer keys");
+
+    uint64_t operator()(Key key) const
+    {
+        return static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+    }
+};
+
+
+// Open-addressing hash table with linear probing and backward-shift deletion.
+// All slots live in one contiguous array, so there is no per-element allocation.
+// Keys and values must be default constructible; any insertion may invalidate
+// iterators and references.
+// Use it through FlatHashMap and FlatHashSet aliases below.
+template <typename Key, typename Value, typename Hash = FlatHash<Key>>
+class FlatHashTable final
+{
+public:
+    using value_type = std::conditional_t<std::is_void_v<Value>, Key, std::pair<Key, Value>>;
+
+    template <bool CONST>
+    class Iterator final
+    {
+    public:
+        using Table = std::conditional_t<CONST, const FlatHashTable, FlatHashTable>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<CONST, const value_type&, value_type&>;
+        using pointer = std::conditional_t<CONST, const value_type*, value_type*>;
+
+    public:
+        Iterator() = default;
+
+        Iterator(Table* table, size_t index)
+            : table_{table}
+            , index_{index}
+        {
+        }
+
+        // iterator -> const_iterator conversion
+        template <bool OTHER, typename = std::enable_if_t<CONST && !OTHER>>
+        Iterator(const Iterator<OTHER>& another)
+            : table_{another.table_}
+            , index_{another.index_}
+        {
+        }
+
+        reference operator*() const
+        {
+            return table_->slots_[index_];
+        }
+
+        pointer operator->() const
+        {
+            return &table_->slots_[index_];
+        }
+
+        Iterator& operator++()
+        {
+            index_ = table_->nextUsed(index_ + 1);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const Iterator& another) const
+        {
+            return index_ == another.index_;
+        }
+
+        bool operator!=(const Iterator& another) const
+        {
+            return index_ != another.index_;
+        }
+
+    private:
+        friend class FlatHashTable;
+        template <bool> friend class Iterator;
+
+        Table* table_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public:
+    FlatHashTable() = default;
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    size_t capacity() const
+    {
+        return slots_.size();
+    }
+
+    void clear()
+    {
+        slots_.clear();
+        used_.clear();
+        size_ = 0;
+        shift_ = 64;
+    }
+
+    void reserve(size_t size)
+    {
+        size_t newCapacity = MIN_CAPACITY;
+        while (!fits(size, newCapacity))
+        {
+            newCapacity *= 2;
+        }
+        if (newCapacity > capacity())
+        {
+            rehash(newCapacity);
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator{this, nextUsed(0)};
+    }
+
+    iterator end()
+    {
+        return iterator{this, capacity()};
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{this, nextUsed(0)};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{this, capacity()};
+    }
+
+    iterator find(const Key& key)
+    {
+        return iterator{this, findIndex(key)};
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        return const_iterator{this, findIndex(key)};
+    }
+
+    bool contains(const Key& key) const
+    {
+        return findIndex(key) != capacity();
+    }
+
+    size_t count(const Key& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Set insertion.
+    template <typename V = Value, typename = std::enable_if_t<std::is_void_v<V>>>
+    std::pair<iterator, bool> insert(const Key& key)
+    {
+        const auto [index, inserted] = findOrInsert(key);
+        return {iterator{this, index}, inserted};
+    }
+
+    // Map insertion, value is constructed from args only if the key is new.
+    template <typename... Args, typename V = Value, typename = std::enable_if_t<!std::is_void_v<V>>>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        const auto [index, inserted] = findOrInsert(key);
+        if (inserted)
+        {
+            slots_[index].second = V(std::forward<Args>(args)...);
+        }
+        return {iterator{this, index}, inserted};
+    }
+
+    template <typename V = Value, typename = std::enable_if_t<!std::is_void_v<V>>>
+    V& operator[](const Key& key)
+    {
+        return slots_[findOrInsert(key).first].second;
+    }
+
+    size_t erase(const Key& key)
+    {
+        const auto index = findIndex(key);
+        if (index == capacity())
+        {
+            return 0;
+        }
+        eraseAt(index);
+        return 1;
+    }
+
+    // Unlike std containers returns nothing, as erasing may move
+    // an already visited element into the erased slot.
+    void erase(const_iterator it)
+    {
+        eraseAt(it.index_);
+    }
+
+private:
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    // Maximal load factor is 3/4.
+    static bool fits(size_t size, size_t capacity)
+    {
+        return size * 4 <= capacity * 3;
+    }
+
+    static const Key& keyOf(const value_type& slot)
+    {
+        if constexpr (std::is_void_v<Value>)
+        {
+            return slot;
+        }
+        else
+        {
+            return slot.first;
+        }
+    }
+
+    size_t mask() const
+    {
+        return capacity() - 1;
+    }
+
+    size_t home(const Key& key) const
+    {
+        return static_cast<size_t>(Hash{}(key) >> shift_);
+    }
+
+    size_t nextUsed(size_t index) const
+    {
+        while (index < used_.size() && !used_[index])
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    size_t findIndex(const Key& key) const
+    {
+        if (size_ == 0)
+        {
+            return capacity();
+        }
+
+        for (auto index = home(key); used_[index]; index = (index + 1) & mask())
+        {
+            if (keyOf(slots_[index]) == key)
+            {
+                return index;
+            }
+        }
+        return capacity();
+    }
+
+    std::pair<size_t, bool> findOrInsert(const Key& key)
+    {
+        if (!fits(size_ + 1, capacity()))
+        {
+            rehash(capacity() == 0 ? MIN_CAPACITY : capacity() * 2);
+        }
+
+        auto index = home(key);
+        for (; used_[index]; index = (index + 1) & mask())
+        {
+            if (keyOf(slots_[index]) == key)
+            {
+                return {index, false};
+            }
+        }
+
+        if constexpr (std::is_void_v<Value>)
+        {
+            slots_[index] = key;
+        }
+        else
+        {
+            slots_[index].first = key;
+        }
+        used_[index] = 1;
+        ++size_;
+        return {index, true};
+    }
+
+    void eraseAt(size_t index)
+    {
+        // shift following elements of the same probe sequence back to close the hole
+        auto hole = index;
+        for (auto next = (hole + 1) & mask(); used_[next]; next = (next + 1) & mask())
+        {
+            const auto nextHome = home(keyOf(slots_[next]));
+            if (((next - nextHome) & mask()) >= ((next - hole) & mask()))
+            {
+                slots_[hole] = std::move(slots_[next]);
+                hole = next;
+            }
+        }
+
+        slots_[hole] = value_type{};
+        used_[hole] = 0;
+        --size_;
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        std::vector<value_type> oldSlots(newCapacity);
+        std::vector<uint8_t> oldUsed(newCapacity, 0);
+        oldSlots.swap(slots_);
+        oldUsed.swap(used_);
+
+        shift_ = 64;
+        for (auto c = newCapacity; c > 1; c /= 2)
+        {
+            --shift_;
+        }
+
+        for (size_t i = 0; i < oldSlots.size(); ++i)
+        {
+            if (!oldUsed[i])
+            {
+                continue;
+            }
+
+            auto index = home(keyOf(oldSlots[i]));
+            while (used_[index])
+            {
+                index = (index + 1) & mask();
+            }
+            slots_[index] = std::move(oldSlots[i]);
+            used_[index] = 1;
+        }
+    }
+
+private:
+    std::vector<value_type> slots_;
+    std::vector<uint8_t> used_;
+    size_t size_ = 0;
+    unsigned shift_ = 64;
+};
+
+
+template <typename Key, typename Value, typename Hash = FlatHash<Key>>
+using FlatHashMap = FlatHashTable<Key, Value, Hash>;
+
+template <typename Key, typename Hash = FlatHash<Key>>
+using FlatHashSet = FlatHashTable<Key, void, Hash>;
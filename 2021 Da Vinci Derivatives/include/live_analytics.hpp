@@ -0,0 +1,74 @@
+#pragma once
+
+#include <buy_order_finder.hpp>
+#include <feed_follower.hpp>
+#include <order_counter.hpp>
+#include <sell_order_finder.hpp>
+#include <types.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+// Keeps OrderCounter, BuyOrderFinder and SellOrderFinder up to date
+// with a growing data file. The file can be followed either by calling
+// update() or by a background thread started with start(). The background
+// thread skips malformed lines and counts them, it stops only on other errors.
+// Queries are safe to call at any moment from any thread.
+class LiveAnalytics final
+{
+public:
+    explicit LiveAnalytics(const std::string& filename);
+    ~LiveAnalytics();
+
+    // Processes all records appended since the last update, returns their number.
+    // On a malformed line the records before it are processed and MalformedLineError is rethrown,
+    // the next update continues after the malformed line.
+    size_t update();
+
+    void start();
+
+    // Stops the background thread, rethrows an error happened in it, if any.
+    void stop();
+
+    // False once the background thread is stopped or failed.
+    bool isRunning() const;
+
+    uint64_t numberOfRecords() const;
+
+    // Number of lines skipped by the background thread.
+    uint64_t numberOfMalformedLines() const;
+
+    std::unordered_map<Symbol, uint32_t> orderCounts() const;
+
+    std::vector<BuyOrderFinder::BuyOrder> biggestBuyOrders(const Symbol& symbol) const;
+
+    std::optional<SellOrderFinder::SellPosition> bestSellAtTime(const Symbol& symbol, const Timestamp& ts) const;
+
+private:
+    void apply();
+    void run();
+    void join();
+
+private:
+    FeedFollower follower_;
+    std::vector<Record> batch_;
+
+    mutable std::mutex mutex_;
+    OrderCounter counter_;
+    BuyOrderFinder buyFinder_;
+    SellOrderFinder sellFinder_;
+    uint64_t numberOfRecords_ = 0;
+    uint64_t numberOfMalformedLines_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::exception_ptr error_;
+};
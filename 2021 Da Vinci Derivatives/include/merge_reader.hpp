@@ -0,0 +1,72 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+constexpr Timestamp US_PER_DAY = 86400000000;
+
+
+// One data file of a merge, its timestamps are shifted by tsOffset,
+// e.g. by n * US_PER_DAY for the n-th session of a multi-day merge.
+struct MergeSource
+{
+    std::string filename;
+    Timestamp tsOffset = 0;
+};
+
+
+// Reads several data files, each sorted by timestamp, as a single stream
+// sorted by timestamp (k-way merge over a heap of file heads).
+// Records with equal timestamps come in the order of their files in the list.
+// Every file keeps at most readAhead parsed records in memory.
+class MergeReader final
+{
+public:
+    static constexpr size_t DEFAULT_READ_AHEAD = 1024;
+
+public:
+    explicit MergeReader(const std::vector<std::string>& filenames, size_t readAhead = DEFAULT_READ_AHEAD);
+    explicit MergeReader(const std::vector<MergeSource>& sources, size_t readAhead = DEFAULT_READ_AHEAD);
+
+    // Returns the next record of the merged stream, nothing when all files are exhausted.
+    // Throws if a file turns out not to be sorted by timestamp.
+    std::optional<Record> next();
+
+private:
+    struct Source
+    {
+        MergeSource source;
+        std::ifstream input;
+        std::vector<Record> buffer;
+        size_t position = 0;
+        Timestamp lastTs = 0;
+    };
+
+    struct Head
+    {
+        Timestamp ts;
+        size_t source;
+    };
+
+    bool refill(Source& source);
+    void pushHead(size_t index);
+
+    static bool later(const Head& a, const Head& b);
+
+private:
+    size_t readAhead_;
+    std::vector<Source> sources_;
+    std::vector<Head> heap_;
+    std::string line_;
+};
+
+
+std::vector<Record> recordsFromFiles(const std::vector<std::string>& filenames);
+
+std::vector<Record> recordsFromFiles(const std::vector<MergeSource>& sources);
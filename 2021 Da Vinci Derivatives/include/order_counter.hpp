@@ -1,9 +1,10 @@
 #pragma once
 
+#include <flat_hash_map.hpp>
+#include <record_columns.hpp>
 #include <types.hpp>
 
 #include <unordered_map>
-#include <unordered_set>
 
 
 class OrderCounter final
@@ -12,10 +13,14 @@ public:
     OrderCounter() = default;
 
     void add(const Record& record);
+    void add(const RecordColumns& columns);
 
     std::unordered_map<Symbol, uint32_t> orderCounts() const;
 
 private:
-    std::unordered_map<Symbol, std::unordered_set<OrderID>> activeOrders_;
-    std::unordered_map<Symbol, uint32_t> numberOfOrders_;
+    void insertOrder(const Symbol& symbol, OrderID orderID);
+    void cancelOrder(const Symbol& symbol, OrderID orderID);
+
+private:
+    FlatHashMap<Symbol, FlatHashSet<OrderID>> activeOrders_;
 };
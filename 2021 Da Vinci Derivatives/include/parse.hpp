@@ -1,5 +1,6 @@
 #pragma once
 
+#include <record_filter.hpp>
 #include <types.hpp>
 
 #include <istream>
@@ -29,3 +30,9 @@ Record recordFromString(const std::string_view& recordString);
 std::vector<Record> recordsFromStream(std::istream& stream);
 
 std::vector<Record> recordsFromFile(const std::string& filename);
+
+// Only records matching the filter are parsed, others are skipped
+// after a look at their timestamp and symbol.
+std::vector<Record> recordsFromStream(std::istream& stream, const RecordFilter& filter);
+
+std::vector<Record> recordsFromFile(const std::string& filename, const RecordFilter& filter);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+// Append-only history of a best price level, compressed in blocks.
+//
+// Every block holds up to BLOCK_SIZE entries as varints: timestamp delta,
+// zigzag price delta (both from the previous entry of the block) and volume.
+// A skip index keeps the first timestamp, the base price and the offset of
+// every block, so a query binary searches the index and decodes one block.
+class PriceHistory final
+{
+public:
+    struct Entry
+    {
+        Timestamp ts;
+        Price price;
+        Volume volume;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    // Walks the history forward for non-decreasing timestamps.
+    class Cursor final
+    {
+    public:
+        explicit Cursor(const PriceHistory& history);
+
+        // Returns the last entry with entry.ts <= ts, nullptr if there is none.
+        // ts must not be less than in the previous call.
+        const Entry* advance(Timestamp ts);
+
+    private:
+        bool decodeNext();
+
+    private:
+        const PriceHistory& history_;
+        size_t index_ = 0;
+        size_t offset_ = 0;
+        Entry current_{};
+        Entry next_{};
+        bool hasCurrent_ = false;
+        bool hasNext_ = false;
+    };
+
+public:
+    PriceHistory() = default;
+
+    // Entries must be added in non-decreasing timestamp order.
+    void add(const Entry& entry);
+
+    bool empty() const;
+    size_t size() const;
+
+    // The last added entry, the history must not be empty.
+    const Entry& back() const;
+
+    // Returns the last entry with entry.ts <= ts.
+    std::optional<Entry> at(Timestamp ts) const;
+
+    // Number of bytes used by entries and the skip index.
+    size_t memoryUsage() const;
+
+private:
+    struct Block
+    {
+        Timestamp ts;
+        Price price;
+        size_t offset;
+    };
+
+private:
+    std::vector<uint8_t> data_;
+    std::vector<Block> blocks_;
+    size_t size_ = 0;
+    Entry last_{};
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <flat_hash_map.hpp>
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Struct-of-arrays storage for records, every field is kept in its own column.
+// Symbols can be dictionary-encoded (32-bit codes instead of 64-bit symbols),
+// timestamps can be stored frame-of-reference style, as 32-bit offsets from a
+// per-block base. They are not deltas between rows, so any row is read directly.
+class RecordColumns final
+{
+public:
+    struct Encoding
+    {
+        bool dictionarySymbols;
+        bool offsetTimestamps;
+    };
+
+public:
+    RecordColumns() = default;
+    explicit RecordColumns(Encoding encoding);
+    explicit RecordColumns(const std::vector<Record>& records, Encoding encoding = {});
+
+    void reserve(size_t size);
+    void push_back(const Record& record);
+
+    size_t size() const;
+    bool empty() const;
+    const Encoding& encoding() const;
+
+    Timestamp timestamp(size_t row) const;
+    Symbol symbol(size_t row) const;
+    Record record(size_t row) const;
+
+    const std::vector<OrderID>& orderIDs() const;
+    const std::vector<Volume>& volumes() const;
+    const std::vector<Price>& prices() const;
+    const std::vector<Operation>& operations() const;
+    const std::vector<Side>& sides() const;
+
+    // Distinct symbols in order of appearance, empty without dictionary encoding.
+    const std::vector<Symbol>& symbolDictionary() const;
+
+    // Indices of all rows of the given side, in ascending order.
+    std::vector<uint32_t> rowsWithSide(Side side) const;
+
+    // Calls callback(const Record&) for every row, in order.
+    template <typename Callback>
+    void forEach(Callback&& callback) const;
+
+    // Calls callback(const Record&) for every row of the given side, in order.
+    template <typename Callback>
+    void forEach(Side side, Callback&& callback) const;
+
+private:
+    struct TimestampBlock
+    {
+        size_t firstRow;
+        Timestamp base;
+    };
+
+    void pushTimestamp(Timestamp ts);
+    void pushSymbol(Symbol symbol);
+    size_t timestampBlock(size_t row) const;
+    Record record(size_t row, size_t block) const;
+
+private:
+    Encoding encoding_{};
+
+    std::vector<Timestamp> timestamps_;
+    std::vector<TimestampBlock> timestampBlocks_;
+    std::vector<uint32_t> timestampOffsets_;
+
+    std::vector<Symbol> symbols_;
+    std::vector<uint32_t> symbolCodes_;
+    std::vector<Symbol> symbolDictionary_;
+    FlatHashMap<Symbol, uint32_t> symbolIndex_;
+
+    std::vector<OrderID> orderIDs_;
+    std::vector<Volume> volumes_;
+    std::vector<Price> prices_;
+    std::vector<Operation> operations_;
+    std::vector<Side> sides_;
+};
+
+
+template <typename Callback>
+void RecordColumns::forEach(Callback&& callback) const
+{
+    size_t block = 0;
+    for (size_t row = 0; row < size(); ++row)
+    {
+        while (block + 1 < timestampBlocks_.size() && timestampBlocks_[block + 1].firstRow <= row)
+        {
+            ++block;
+        }
+        callback(record(row, block));
+    }
+}
+
+template <typename Callback>
+void RecordColumns::forEach(Side side, Callback&& callback) const
+{
+    size_t block = 0;
+    for (const auto row : rowsWithSide(side))
+    {
+        while (block + 1 < timestampBlocks_.size() && timestampBlocks_[block + 1].firstRow <= row)
+        {
+            ++block;
+        }
+        callback(record(row, block));
+    }
+}
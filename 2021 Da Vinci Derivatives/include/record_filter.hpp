@@ -0,0 +1,33 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+// Predicate applied to records while they are loaded.
+struct RecordFilter
+{
+    // Symbols to keep, empty means all symbols.
+    std::vector<Symbol> symbols;
+
+    // Inclusive timestamp window.
+    Timestamp from = 0;
+    Timestamp to = std::numeric_limits<Timestamp>::max();
+
+    // If records are known to be ordered by timestamp,
+    // loading stops at the first record after the window.
+    bool sortedByTime = false;
+
+    bool matchesTimestamp(Timestamp ts) const
+    {
+        return from <= ts && ts <= to;
+    }
+
+    bool matchesSymbol(Symbol symbol) const
+    {
+        return symbols.empty() || std::find(symbols.begin(), symbols.end(), symbol) != symbols.end();
+    }
+};
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <flat_hash_map.hpp>
+#include <price_history.hpp>
+#include <record_columns.hpp>
 #include <types.hpp>
 
+#include <cstddef>
 #include <map>
 #include <optional>
 #include <unordered_map>
@@ -21,27 +25,33 @@ public:
     SellOrderFinder() = default;
 
     void add(const Record& record);
+    void add(const RecordColumns& columns);
 
     std::optional<SellPosition> bestSellAtTime(const Symbol& symbol, const Timestamp& ts) const;
 
+    // Same as bestSellAtTime for every timestamp, but in one pass over the history.
+    // Timestamps must be sorted, results are in the same order.
+    std::vector<std::optional<SellPosition>> bestSellAtTimes(const Symbol& symbol, const std::vector<Timestamp>& sortedTs) const;
+
+    // The batch query for every known symbol, symbols are split between
+    // numberOfThreads threads (0 means hardware concurrency).
+    std::unordered_map<Symbol, std::vector<std::optional<SellPosition>>> bestSellAtTimes(const std::vector<Timestamp>& sortedTs,
+                                                                                         size_t numberOfThreads = 0) const;
+
 private:
     void addOrder(const Record& record);
-    void removeOrder(const Record& record, bool updateHistory);
+    void removeOrder(const Symbol& symbol, OrderID orderID, Timestamp ts, bool updateHistory);
 
 private:
-    struct HistoryRecord
-    {
-        Timestamp ts;
-        Price price;
-        Volume volume;
-    };
-
     struct SellOrdersData
     {
-        std::unordered_map<OrderID, SellPosition> activeOrders;
+        FlatHashMap<OrderID, SellPosition> activeOrders;
         std::map<Price, Volume> activePrices;
-        std::vector<HistoryRecord> priceHistory;
+        PriceHistory priceHistory;
     };
 
-    std::unordered_map<Symbol, SellOrdersData> sellOrders_;
+    static std::vector<std::optional<SellPosition>> sweepHistory(const PriceHistory& priceHistory,
+                                                                  const std::vector<Timestamp>& sortedTs);
+
+    FlatHashMap<Symbol, SellOrdersData> sellOrders_;
 };
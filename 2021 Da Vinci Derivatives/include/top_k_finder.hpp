@@ -0,0 +1,358 @@
+#pragma once
+
+#include <flat_hash_map.hpp>
+#include <record_columns.hpp>
+#include <types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// Ranking keys for TopKFinder, the bigger the key the better the order.
+struct VolumeKey
+{
+    static int64_t key(Volume volume, Price)
+    {
+        return volume;
+    }
+};
+
+struct PriceKey
+{
+    static int64_t key(Volume, Price price)
+    {
+        return price;
+    }
+};
+
+struct NotionalKey
+{
+    static int64_t key(Volume volume, Price price)
+    {
+        return static_cast<int64_t>(volume) * price;
+    }
+};
+
+
+// Keeps K best active orders of one side per symbol.
+// Every active order is stored in a flat pool: any of them may get into the top
+// after cancels, so the pool cannot be bounded without losing exactness. The best
+// orders are kept in a small sorted top set of up to 2K orders, all the others are
+// candidates. Candidates are appended in O(1) and made a heap only once the top set
+// needs them. Cancels of candidates only leave stale entries, which are dropped when
+// popped or when they outnumber the active orders. Once cancels drain the top set
+// below K, it is refilled with the next best candidates popped from the heap, so
+// even a stream of cancels at the top costs O(log N) per cancel instead of a scan
+// of the pool. Queries do not modify anything. Not thread-safe.
+template <Side SIDE, typename Key = VolumeKey>
+class TopKFinder final
+{
+public:
+    struct Order
+    {
+        Timestamp ts;
+        Symbol symbol;
+        OrderID orderID;
+        Volume volume;
+        Price price;
+    };
+
+public:
+    explicit TopKFinder(size_t k);
+
+    void add(const Record& record);
+    void add(const RecordColumns& columns);
+
+    std::vector<Order> top(const Symbol& symbol) const;
+
+    size_t k() const;
+
+private:
+    struct Entry
+    {
+        Order order;
+        int64_t key;
+        uint64_t sequence;
+    };
+
+    struct SymbolData
+    {
+        FlatHashMap<OrderID, Entry> pool;
+        std::vector<Entry> top;
+        // active orders out of the top set and stale entries,
+        // the first heapSize of them are a max-heap, the rest are not ordered yet
+        std::vector<Entry> candidates;
+        size_t heapSize = 0;
+        size_t staleCandidates = 0;
+    };
+
+    // Order with bigger key goes first, then bigger volume, then bigger price,
+    // then the one added earlier.
+    static bool better(const Entry& a, const Entry& b);
+    static bool worse(const Entry& a, const Entry& b);
+
+    void addOrder(const Record& record);
+    void removeOrder(const Symbol& symbol, OrderID orderID);
+    static void forget(SymbolData& data, OrderID orderID);
+    static void makeHeap(SymbolData& data);
+    static bool isActive(const SymbolData& data, const Entry& entry);
+    void refill(SymbolData& data) const;
+
+private:
+    size_t k_;
+    size_t capacity_;
+    uint64_t sequence_ = 0;
+    FlatHashMap<Symbol, SymbolData> orders_;
+};
+
+
+template <Side SIDE, typename Key>
+TopKFinder<SIDE, Key>::TopKFinder(size_t k)
+    : k_{k}
+    , capacity_{2 * k}
+{
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::add(const Record& record)
+{
+    if (record.side != SIDE)
+    {
+        return;
+    }
+
+    switch (record.operation)
+    {
+        case Operation::INSERT:
+            addOrder(record);
+            break;
+
+        case Operation::CANCEL:
+            removeOrder(record.symbol, record.orderID);
+            break;
+
+        case Operation::AMEND:
+            removeOrder(record.symbol, record.orderID);
+            addOrder(record);
+            break;
+    }
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::add(const RecordColumns& columns)
+{
+    // a cancel needs only the symbol and order ID columns
+    const auto& operations = columns.operations();
+    const auto& orderIDs = columns.orderIDs();
+    for (const auto row : columns.rowsWithSide(SIDE))
+    {
+        switch (operations[row])
+        {
+            case Operation::INSERT:
+                addOrder(columns.record(row));
+                break;
+
+            case Operation::CANCEL:
+                removeOrder(columns.symbol(row), orderIDs[row]);
+                break;
+
+            case Operation::AMEND:
+                removeOrder(columns.symbol(row), orderIDs[row]);
+                addOrder(columns.record(row));
+                break;
+        }
+    }
+}
+
+template <Side SIDE, typename Key>
+std::vector<typename TopKFinder<SIDE, Key>::Order> TopKFinder<SIDE, Key>::top(const Symbol& symbol) const
+{
+    std::vector<Order> result;
+
+    const auto orderDataIt = orders_.find(symbol);
+    if (orderDataIt == orders_.end())
+    {
+        return result;
+    }
+
+    const auto& data = orderDataIt->second;
+    const auto count = std::min(k_, data.top.size());
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        result.push_back(data.top[i].order);
+    }
+
+    return result;
+}
+
+template <Side SIDE, typename Key>
+size_t TopKFinder<SIDE, Key>::k() const
+{
+    return k_;
+}
+
+template <Side SIDE, typename Key>
+bool TopKFinder<SIDE, Key>::better(const Entry& a, const Entry& b)
+{
+    if (a.key != b.key) return a.key > b.key;
+    if (a.order.volume != b.order.volume) return a.order.volume > b.order.volume;
+    if (a.order.price != b.order.price) return a.order.price > b.order.price;
+    return a.sequence < b.sequence;
+}
+
+template <Side SIDE, typename Key>
+bool TopKFinder<SIDE, Key>::worse(const Entry& a, const Entry& b)
+{
+    return better(b, a);
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::addOrder(const Record& record)
+{
+    if (k_ == 0)
+    {
+        return;
+    }
+
+    auto& data = orders_[record.symbol];
+
+    const Entry entry{Order{record.ts, record.symbol, record.orderID, record.volume, record.price},
+                      Key::key(record.volume, record.price),
+                      sequence_++};
+
+    // repeated insert of the same order replaces it
+    forget(data, record.orderID);
+    data.pool.try_emplace(record.orderID, entry);
+
+    // The top set always holds the best top.size() orders of the pool,
+    // so a new order goes there only if it doesn't break this invariant.
+    const bool topHasWholePool = data.top.size() + 1 == data.pool.size();
+    if (topHasWholePool || (!data.top.empty() && better(entry, data.top.back())))
+    {
+        const auto position = std::upper_bound(data.top.begin(), data.top.end(), entry, better);
+        data.top.insert(position, entry);
+        if (data.top.size() > capacity_)
+        {
+            data.candidates.push_back(data.top.back());
+            data.top.pop_back();
+        }
+    }
+    else
+    {
+        data.candidates.push_back(entry);
+    }
+
+    // a replaced order may have left the top set
+    refill(data);
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::removeOrder(const Symbol& symbol, OrderID orderID)
+{
+    const auto symbolDataIt = orders_.find(symbol);
+    if (symbolDataIt == orders_.end())
+    {
+        return;
+    }
+
+    auto& data = symbolDataIt->second;
+    if (!data.pool.contains(orderID))
+    {
+        return;
+    }
+
+    forget(data, orderID);
+    if (data.pool.empty())
+    {
+        orders_.erase(symbolDataIt);
+    }
+    else
+    {
+        refill(data);
+    }
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::forget(SymbolData& data, OrderID orderID)
+{
+    if (data.pool.erase(orderID) == 0)
+    {
+        return;
+    }
+
+    const auto it = std::find_if(data.top.begin(),
+                                 data.top.end(),
+                                 [orderID](const auto& entry){ return entry.order.orderID == orderID; });
+    if (it != data.top.end())
+    {
+        data.top.erase(it);
+        return;
+    }
+
+    // the order stays in the heap as a stale entry, once they are the majority the heap is rebuilt
+    if (++data.staleCandidates > data.pool.size())
+    {
+        const auto stale = std::remove_if(data.candidates.begin(),
+                                          data.candidates.end(),
+                                          [&data](const auto& entry){ return !isActive(data, entry); });
+        data.candidates.erase(stale, data.candidates.end());
+        data.heapSize = 0;
+        data.staleCandidates = 0;
+    }
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::makeHeap(SymbolData& data)
+{
+    const auto unordered = data.candidates.size() - data.heapSize;
+    if (unordered > data.heapSize)
+    {
+        std::make_heap(data.candidates.begin(), data.candidates.end(), worse);
+    }
+    else
+    {
+        for (auto i = data.heapSize; i < data.candidates.size(); ++i)
+        {
+            std::push_heap(data.candidates.begin(), data.candidates.begin() + static_cast<std::ptrdiff_t>(i) + 1, worse);
+        }
+    }
+    data.heapSize = data.candidates.size();
+}
+
+template <Side SIDE, typename Key>
+bool TopKFinder<SIDE, Key>::isActive(const SymbolData& data, const Entry& entry)
+{
+    const auto it = data.pool.find(entry.order.orderID);
+    return it != data.pool.end() && it->second.sequence == entry.sequence;
+}
+
+template <Side SIDE, typename Key>
+void TopKFinder<SIDE, Key>::refill(SymbolData& data) const
+{
+    if (data.top.size() >= k_)
+    {
+        return;
+    }
+
+    // every candidate is worse than the top set, so the best ones are appended to its end
+    makeHeap(data);
+    while (data.top.size() < capacity_ && !data.candidates.empty())
+    {
+        std::pop_heap(data.candidates.begin(), data.candidates.end(), worse);
+        const auto entry = data.candidates.back();
+        data.candidates.pop_back();
+        --data.heapSize;
+
+        if (isActive(data, entry))
+        {
+            data.top.push_back(entry);
+        }
+        else
+        {
+            --data.staleCandidates;
+        }
+    }
+}
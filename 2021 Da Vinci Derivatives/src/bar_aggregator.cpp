@@ -0,0 +1,366 @@
+#include <bar_aggregator.hpp>
+#include <parse.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    // Integers are stored in native (little-endian on all supported platforms) byte order.
+    constexpr std::array<char, 8> MAGIC = {'D', 'V', 'B', 'A', 'R', 'S', '0', '1'};
+    constexpr uint32_t VERSION = 1;
+
+    const char* const CSV_HEADER = "symbol,start,buy_volume,sell_volume,cancel_volume,vwap,"
+                                   "bid_open,bid_high,bid_low,bid_close,ask_open,ask_high,ask_low,ask_close,profile";
+
+    // Calls function for every column, in the order they are stored in a binary file.
+    template <typename Columns, typename Function>
+    void forEachColumn(Columns& columns, Function&& function)
+    {
+        function(columns.start);
+        function(columns.buyVolume);
+        function(columns.sellVolume);
+        function(columns.cancelVolume);
+        function(columns.notional);
+        function(columns.bidOpen);
+        function(columns.bidHigh);
+        function(columns.bidLow);
+        function(columns.bidClose);
+        function(columns.askOpen);
+        function(columns.askHigh);
+        function(columns.askLow);
+        function(columns.askClose);
+        function(columns.profileOffset);
+        function(columns.profilePrice);
+        function(columns.profileVolume);
+    }
+
+    void updatePrice(Price price, bool opened, Price& open, Price& high, Price& low, Price& close)
+    {
+        if (opened)
+        {
+            open = price;
+        }
+        if (price != BarColumns::NO_PRICE)
+        {
+            high = high == BarColumns::NO_PRICE ? price : std::max(high, price);
+            low = low == BarColumns::NO_PRICE ? price : std::min(low, price);
+        }
+        close = price;
+    }
+
+    void writePrice(std::ostream& stream, Price price)
+    {
+        stream << ',';
+        if (price != BarColumns::NO_PRICE)
+        {
+            stream << priceToDouble(price);
+        }
+    }
+
+    template <typename T>
+    void writeFixed(std::ostream& stream, T value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readFixed(std::istream& stream)
+    {
+        T value;
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Malformed bars data");
+        }
+        return value;
+    }
+
+    uint64_t remainingBytes(std::istream& stream, uint64_t fileSize)
+    {
+        return fileSize - static_cast<uint64_t>(stream.tellg());
+    }
+
+    // Columns read from a file must describe bars the same way BarAggregator makes them.
+    void checkColumns(const BarColumns& columns)
+    {
+        const auto bars = columns.size();
+        const auto haveBars = [bars](const auto&... column){ return ((column.size() == bars) && ...); };
+
+        const auto& offsets = columns.profileOffset;
+        const auto valid = haveBars(columns.buyVolume, columns.sellVolume, columns.cancelVolume, columns.notional,
+                                    columns.bidOpen, columns.bidHigh, columns.bidLow, columns.bidClose,
+                                    columns.askOpen, columns.askHigh, columns.askLow, columns.askClose)
+            && offsets.size() == bars + 1
+            && offsets.front() == 0
+            && std::is_sorted(offsets.begin(), offsets.end())
+            && offsets.back() == columns.profilePrice.size()
+            && columns.profileVolume.size() == columns.profilePrice.size();
+
+        if (!valid)
+        {
+            throw std::runtime_error("Malformed bars data");
+        }
+    }
+}
+
+size_t BarColumns::size() const
+{
+    return start.size();
+}
+
+double BarColumns::vwap(size_t bar) const
+{
+    const auto volume = buyVolume[bar] + sellVolume[bar];
+    return volume == 0 ? 0.0 : static_cast<double>(notional[bar]) / static_cast<double>(volume);
+}
+
+BarAggregator::BarAggregator(Timestamp width)
+    : width_{width}
+{
+    if (width_ == 0)
+    {
+        throw std::runtime_error("Bar width must be positive");
+    }
+}
+
+void BarAggregator::add(const Record& record)
+{
+    auto& data = bars_[record.symbol];
+    auto& columns = data.columns;
+
+    // a rejected record must not get into the book
+    const auto start = record.ts - record.ts % width_;
+    if (!columns.start.empty() && columns.start.back() > start)
+    {
+        throw std::runtime_error("Records of symbol " + symbolToString(record.symbol) + " are not sorted by timestamp");
+    }
+
+    book_.add(record);
+
+    const auto opened = columns.start.empty() || columns.start.back() < start;
+    if (opened)
+    {
+        openBar(data, start);
+    }
+
+    const auto bar = columns.size() - 1;
+    switch (record.operation)
+    {
+        case Operation::INSERT:
+        case Operation::AMEND:
+            (record.side == Side::BUY ? columns.buyVolume : columns.sellVolume)[bar] += record.volume;
+            columns.notional[bar] += static_cast<int64_t>(record.price) * record.volume;
+            updateProfile(data, record.price, record.volume);
+            break;
+
+        case Operation::CANCEL:
+            columns.cancelVolume[bar] += record.volume;
+            break;
+    }
+
+    const auto bid = book_.bestBid(record.symbol);
+    updatePrice(bid ? bid->price : BarColumns::NO_PRICE, opened,
+                columns.bidOpen[bar], columns.bidHigh[bar], columns.bidLow[bar], columns.bidClose[bar]);
+
+    const auto ask = book_.bestAsk(record.symbol);
+    updatePrice(ask ? ask->price : BarColumns::NO_PRICE, opened,
+                columns.askOpen[bar], columns.askHigh[bar], columns.askLow[bar], columns.askClose[bar]);
+}
+
+void BarAggregator::add(const RecordColumns& columns)
+{
+    columns.forEach([this](const Record& record){ add(record); });
+}
+
+Timestamp BarAggregator::width() const
+{
+    return width_;
+}
+
+std::vector<Symbol> BarAggregator::symbols() const
+{
+    std::vector<Symbol> result;
+    result.reserve(bars_.size());
+    for (const auto& [symbol, data] : bars_)
+    {
+        result.push_back(symbol);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+const BarColumns& BarAggregator::bars(const Symbol& symbol) const
+{
+    static const BarColumns EMPTY;
+
+    const auto it = bars_.find(symbol);
+    return it == bars_.end() ? EMPTY : it->second.columns;
+}
+
+void BarAggregator::writeCsv(std::ostream& stream) const
+{
+    stream << CSV_HEADER << "\n";
+
+    for (const auto symbol : symbols())
+    {
+        const auto& columns = bars(symbol);
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            stream << symbolToString(symbol) << ','
+                   << timestampToString(columns.start[i]) << ','
+                   << columns.buyVolume[i] << ','
+                   << columns.sellVolume[i] << ','
+                   << columns.cancelVolume[i] << ','
+                   // vwap is in Price units, i.e. scaled as priceToDouble(1)
+                   << columns.vwap(i) * priceToDouble(1);
+
+            writePrice(stream, columns.bidOpen[i]);
+            writePrice(stream, columns.bidHigh[i]);
+            writePrice(stream, columns.bidLow[i]);
+            writePrice(stream, columns.bidClose[i]);
+            writePrice(stream, columns.askOpen[i]);
+            writePrice(stream, columns.askHigh[i]);
+            writePrice(stream, columns.askLow[i]);
+            writePrice(stream, columns.askClose[i]);
+
+            stream << ',';
+            for (auto j = columns.profileOffset[i]; j < columns.profileOffset[i + 1]; ++j)
+            {
+                stream << (j == columns.profileOffset[i] ? "" : " ")
+                       << priceToDouble(columns.profilePrice[j]) << ':' << columns.profileVolume[j];
+            }
+            stream << "\n";
+        }
+    }
+}
+
+void BarAggregator::writeCsv(const std::string& filename) const
+{
+    std::ofstream output(filename, std::ios::trunc);
+    if (!output.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for writing.");
+    }
+    writeCsv(output);
+}
+
+void BarAggregator::writeBinary(const std::string& filename) const
+{
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for writing.");
+    }
+
+    output.write(MAGIC.data(), MAGIC.size());
+    writeFixed<uint32_t>(output, VERSION);
+    writeFixed<uint64_t>(output, width_);
+
+    const auto allSymbols = symbols();
+    writeFixed<uint64_t>(output, allSymbols.size());
+    for (const auto symbol : allSymbols)
+    {
+        writeFixed<uint64_t>(output, symbol);
+        forEachColumn(bars(symbol), [&](const auto& column)
+        {
+            writeFixed<uint64_t>(output, column.size());
+            output.write(reinterpret_cast<const char*>(column.data()),
+                         static_cast<std::streamsize>(column.size() * sizeof(column[0])));
+        });
+    }
+
+    if (!output.good())
+    {
+        throw std::runtime_error("Failed to write file '" + filename + "'.");
+    }
+}
+
+void BarAggregator::openBar(SymbolBars& data, Timestamp start)
+{
+    auto& columns = data.columns;
+
+    columns.start.push_back(start);
+    columns.buyVolume.push_back(0);
+    columns.sellVolume.push_back(0);
+    columns.cancelVolume.push_back(0);
+    columns.notional.push_back(0);
+    for (auto* prices : {&columns.bidOpen, &columns.bidHigh, &columns.bidLow, &columns.bidClose,
+                         &columns.askOpen, &columns.askHigh, &columns.askLow, &columns.askClose})
+    {
+        prices->push_back(BarColumns::NO_PRICE);
+    }
+    columns.profileOffset.push_back(columns.profileOffset.back());
+
+    data.profileIndex.clear();
+}
+
+void BarAggregator::updateProfile(SymbolBars& data, Price price, Volume volume)
+{
+    auto& columns = data.columns;
+
+    const auto [it, inserted] = data.profileIndex.try_emplace(price, static_cast<uint32_t>(columns.profilePrice.size()));
+    if (inserted)
+    {
+        columns.profilePrice.push_back(price);
+        columns.profileVolume.push_back(0);
+        ++columns.profileOffset.back();
+    }
+    columns.profileVolume[it->second] += volume;
+}
+
+BarFile barsFromFile(const std::string& filename)
+{
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for reading.");
+    }
+
+    input.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(input.tellg());
+    input.seekg(0, std::ios::beg);
+
+    std::array<char, MAGIC.size()> magic;
+    if (!input.read(magic.data(), magic.size()) || magic != MAGIC)
+    {
+        throw std::runtime_error("Not a bars file");
+    }
+    if (readFixed<uint32_t>(input) != VERSION)
+    {
+        throw std::runtime_error("Unsupported bars file version");
+    }
+
+    BarFile result;
+    result.width = readFixed<uint64_t>(input);
+
+    const auto numberOfSymbols = readFixed<uint64_t>(input);
+    for (uint64_t i = 0; i < numberOfSymbols; ++i)
+    {
+        const auto symbol = readFixed<uint64_t>(input);
+
+        BarColumns columns;
+        forEachColumn(columns, [&](auto& column)
+        {
+            // a corrupted length must not turn into a huge allocation
+            const auto length = readFixed<uint64_t>(input);
+            if (length > remainingBytes(input, fileSize) / sizeof(column[0]))
+            {
+                throw std::runtime_error("Malformed bars data");
+            }
+
+            column.resize(length);
+            if (!input.read(reinterpret_cast<char*>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(column[0]))))
+            {
+                throw std::runtime_error("Malformed bars data");
+            }
+        });
+        checkColumns(columns);
+
+        result.symbols.emplace_back(symbol, std::move(columns));
+    }
+
+    return result;
+}
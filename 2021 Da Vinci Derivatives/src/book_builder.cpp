@@ -0,0 +1,447 @@
+#include <book_builder.hpp>
+
+#include <algorithm>
+
+namespace
+{
+    // Number of price levels around the best price kept in the flat ladder of a side.
+    constexpr int64_t WINDOW_SIZE = 512;
+
+    // Number of orders inserted out of the window after which it is moved to them,
+    // the cost of moving (a scan of the window) is spread over these map operations.
+    constexpr uint32_t MISSES_TO_RECENTRE = WINDOW_SIZE / 4;
+}
+
+void BookBuilder::add(const Record& record)
+{
+    switch (record.operation)
+    {
+        case Operation::INSERT:
+        case Operation::AMEND:
+            {
+                auto& book = books_[record.symbol];
+
+                // a repeated insert replaces the order, an amend moves it to the end of the queue
+                const auto [orderIt, inserted] = book.orders.try_emplace(record.orderID, NONE);
+                if (!inserted)
+                {
+                    const auto node = orderIt->second;
+                    if (nodes_[node].side == record.side && nodes_[node].price == record.price)
+                    {
+                        requeueNode(book, node, record);
+                        break;
+                    }
+                    unlinkNode(book, node);
+                }
+                orderIt->second = addOrder(book, record);
+            }
+            break;
+
+        case Operation::CANCEL:
+            {
+                const auto bookIt = books_.find(record.symbol);
+                if (bookIt == books_.end())
+                {
+                    break;
+                }
+
+                auto& book = bookIt->second;
+                const auto orderIt = book.orders.find(record.orderID);
+                if (orderIt != book.orders.end())
+                {
+                    unlinkNode(book, orderIt->second);
+                    book.orders.erase(orderIt);
+                }
+            }
+            break;
+    }
+}
+
+void BookBuilder::add(const RecordColumns& columns)
+{
+    columns.forEach([this](const Record& record){ add(record); });
+}
+
+std::optional<BookBuilder::Level> BookBuilder::bestBid(const Symbol& symbol) const
+{
+    const auto bookIt = books_.find(symbol);
+    return bookIt == books_.end() ? std::nullopt : bestLevel(bookIt->second.bids);
+}
+
+std::optional<BookBuilder::Level> BookBuilder::bestAsk(const Symbol& symbol) const
+{
+    const auto bookIt = books_.find(symbol);
+    return bookIt == books_.end() ? std::nullopt : bestLevel(bookIt->second.asks);
+}
+
+BookBuilder::L2Snapshot BookBuilder::l2(const Symbol& symbol, size_t depth) const
+{
+    L2Snapshot result;
+
+    const auto bookIt = books_.find(symbol);
+    if (bookIt == books_.end())
+    {
+        return result;
+    }
+
+    const auto& book = bookIt->second;
+    forEachLevel(book.bids, Side::BUY, depth, [&](Price price, const LevelData& level)
+    {
+        result.bids.push_back(Level{price, level.volume, level.orders});
+    });
+    forEachLevel(book.asks, Side::SELL, depth, [&](Price price, const LevelData& level)
+    {
+        result.asks.push_back(Level{price, level.volume, level.orders});
+    });
+
+    return result;
+}
+
+BookBuilder::L3Snapshot BookBuilder::l3(const Symbol& symbol, size_t depth) const
+{
+    L3Snapshot result;
+
+    const auto bookIt = books_.find(symbol);
+    if (bookIt == books_.end())
+    {
+        return result;
+    }
+
+    const auto collect = [this](std::vector<OrderLevel>& levels)
+    {
+        return [this, &levels](Price price, const LevelData& level)
+        {
+            auto& orderLevel = levels.emplace_back(OrderLevel{price, level.volume, {}});
+            orderLevel.orders.reserve(level.orders);
+            for (auto node = level.head; node != NONE; node = nodes_[node].next)
+            {
+                orderLevel.orders.push_back(Order{nodes_[node].orderID, nodes_[node].volume, nodes_[node].ts});
+            }
+        };
+    };
+
+    const auto& book = bookIt->second;
+    forEachLevel(book.bids, Side::BUY, depth, collect(result.bids));
+    forEachLevel(book.asks, Side::SELL, depth, collect(result.asks));
+
+    return result;
+}
+
+size_t BookBuilder::numberOfOrders(const Symbol& symbol) const
+{
+    const auto bookIt = books_.find(symbol);
+    return bookIt == books_.end() ? 0 : bookIt->second.orders.size();
+}
+
+uint32_t BookBuilder::addOrder(SymbolBook& book, const Record& record)
+{
+    auto& ladder = record.side == Side::BUY ? book.bids : book.asks;
+
+    const auto newBest = !ladder.best || better(record.side, record.price, *ladder.best);
+    if (newBest)
+    {
+        recentre(ladder, record.price);
+        ladder.best = record.price;
+    }
+
+    // a stale best order far from the market must not keep the window away from it
+    if (!inWindow(ladder, record.price) && ++ladder.misses >= MISSES_TO_RECENTRE)
+    {
+        recentre(ladder, record.price);
+    }
+
+    const auto node = allocateNode();
+    auto& level = levelOf(ladder, record.price);
+
+    nodes_[node] = Node{record.orderID, record.volume, record.ts, record.price, record.side, level.tail, NONE};
+    if (level.tail == NONE)
+    {
+        level.head = node;
+        if (inWindow(ladder, record.price))
+        {
+            ++ladder.windowLevels;
+        }
+    }
+    else
+    {
+        nodes_[level.tail].next = node;
+    }
+    level.tail = node;
+    level.volume += record.volume;
+    ++level.orders;
+
+    return node;
+}
+
+void BookBuilder::requeueNode(SymbolBook& book, uint32_t node, const Record& record)
+{
+    auto& current = nodes_[node];
+    auto& ladder = current.side == Side::BUY ? book.bids : book.asks;
+    auto& level = levelOf(ladder, current.price);
+
+    level.volume = level.volume - current.volume + record.volume;
+    current.volume = record.volume;
+    current.ts = record.ts;
+
+    if (level.tail == node)
+    {
+        return;
+    }
+
+    // the level keeps at least this node, so it stays where it is
+    if (current.prev == NONE)
+    {
+        level.head = current.next;
+    }
+    else
+    {
+        nodes_[current.prev].next = current.next;
+    }
+    nodes_[current.next].prev = current.prev;
+
+    nodes_[level.tail].next = node;
+    current.prev = level.tail;
+    current.next = NONE;
+    level.tail = node;
+}
+
+void BookBuilder::unlinkNode(SymbolBook& book, uint32_t node)
+{
+    const auto& current = nodes_[node];
+    auto& ladder = current.side == Side::BUY ? book.bids : book.asks;
+    auto& level = levelOf(ladder, current.price);
+
+    if (current.prev == NONE)
+    {
+        level.head = current.next;
+    }
+    else
+    {
+        nodes_[current.prev].next = current.next;
+    }
+
+    if (current.next == NONE)
+    {
+        level.tail = current.prev;
+    }
+    else
+    {
+        nodes_[current.next].prev = current.prev;
+    }
+
+    level.volume -= current.volume;
+    --level.orders;
+
+    if (level.orders == 0)
+    {
+        releaseLevel(ladder, current.price);
+        if (current.price == *ladder.best)
+        {
+            findNextBest(ladder, current.side, current.price);
+        }
+    }
+
+    releaseNode(node);
+}
+
+uint32_t BookBuilder::allocateNode()
+{
+    if (freeNodes_ != NONE)
+    {
+        const auto node = freeNodes_;
+        freeNodes_ = nodes_[node].next;
+        return node;
+    }
+
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void BookBuilder::releaseNode(uint32_t index)
+{
+    nodes_[index].next = freeNodes_;
+    freeNodes_ = index;
+}
+
+std::optional<BookBuilder::Level> BookBuilder::bestLevel(const Ladder& ladder)
+{
+    if (!ladder.best)
+    {
+        return std::nullopt;
+    }
+
+    const auto price = *ladder.best;
+    const auto& level = inWindow(ladder, price) ? ladder.levels[static_cast<size_t>(price - ladder.base)] : ladder.outside.at(price);
+    return Level{price, level.volume, level.orders};
+}
+
+bool BookBuilder::better(Side side, Price a, Price b)
+{
+    return side == Side::BUY ? a > b : a < b;
+}
+
+bool BookBuilder::inWindow(const Ladder& ladder, Price price)
+{
+    return price >= ladder.base && price < ladder.base + WINDOW_SIZE;
+}
+
+BookBuilder::LevelData& BookBuilder::levelOf(Ladder& ladder, Price price)
+{
+    return inWindow(ladder, price) ? ladder.levels[static_cast<size_t>(price - ladder.base)] : ladder.outside[price];
+}
+
+void BookBuilder::releaseLevel(Ladder& ladder, Price price)
+{
+    if (inWindow(ladder, price))
+    {
+        --ladder.windowLevels;
+    }
+    else
+    {
+        ladder.outside.erase(price);
+    }
+}
+
+void BookBuilder::recentre(Ladder& ladder, Price price)
+{
+    if (!ladder.levels.empty() && inWindow(ladder, price))
+    {
+        return;
+    }
+
+    // keep the whole window within the range of prices
+    const auto newBase = std::clamp<int64_t>(static_cast<int64_t>(price) - WINDOW_SIZE / 2,
+                                             std::numeric_limits<Price>::min(),
+                                             static_cast<int64_t>(std::numeric_limits<Price>::max()) - WINDOW_SIZE + 1);
+
+    if (ladder.levels.empty())
+    {
+        ladder.levels.resize(WINDOW_SIZE);
+    }
+    else
+    {
+        for (size_t i = 0; i < ladder.levels.size() && ladder.windowLevels != 0; ++i)
+        {
+            if (ladder.levels[i].orders != 0)
+            {
+                ladder.outside.emplace(static_cast<Price>(ladder.base + static_cast<int64_t>(i)), ladder.levels[i]);
+                ladder.levels[i] = LevelData{};
+                --ladder.windowLevels;
+            }
+        }
+    }
+    ladder.base = newBase;
+    ladder.misses = 0;
+
+    auto it = ladder.outside.lower_bound(static_cast<Price>(newBase));
+    while (it != ladder.outside.end() && inWindow(ladder, it->first))
+    {
+        ladder.levels[static_cast<size_t>(it->first - ladder.base)] = it->second;
+        ++ladder.windowLevels;
+        it = ladder.outside.erase(it);
+    }
+}
+
+void BookBuilder::findNextBest(Ladder& ladder, Side side, Price previousBest)
+{
+    // every level left is worse than the previous best, so the candidates are the first
+    // non-empty level of the window after it and the best level outside of the window
+    std::optional<Price> best;
+    if (ladder.windowLevels != 0)
+    {
+        const auto from = std::clamp<int64_t>(previousBest - ladder.base, -1, WINDOW_SIZE);
+        if (side == Side::BUY)
+        {
+            for (auto index = from - 1; index >= 0 && !best; --index)
+            {
+                if (ladder.levels[static_cast<size_t>(index)].orders != 0)
+                {
+                    best = static_cast<Price>(ladder.base + index);
+                }
+            }
+        }
+        else
+        {
+            for (auto index = from + 1; index < WINDOW_SIZE && !best; ++index)
+            {
+                if (ladder.levels[static_cast<size_t>(index)].orders != 0)
+                {
+                    best = static_cast<Price>(ladder.base + index);
+                }
+            }
+        }
+    }
+
+    if (!ladder.outside.empty())
+    {
+        const auto outsideBest = side == Side::BUY ? ladder.outside.rbegin()->first : ladder.outside.begin()->first;
+        if (!best || better(side, outsideBest, *best))
+        {
+            best = outsideBest;
+        }
+    }
+
+    ladder.best = best;
+    if (best)
+    {
+        recentre(ladder, *best);
+    }
+}
+
+template <typename Callback>
+void BookBuilder::forEachLevel(const Ladder& ladder, Side side, size_t depth, Callback&& callback)
+{
+    if (!ladder.best)
+    {
+        return;
+    }
+
+    size_t count = 0;
+    const auto visit = [&](Price price, const LevelData& level)
+    {
+        callback(price, level);
+        ++count;
+    };
+
+    // outside levels on the better side of the window, the window, outside levels on the worse side
+    const auto windowEnd = ladder.base + WINDOW_SIZE;
+    if (side == Side::BUY)
+    {
+        for (auto it = ladder.outside.rbegin(); it != ladder.outside.rend() && it->first >= windowEnd && count < depth; ++it)
+        {
+            visit(it->first, it->second);
+        }
+        for (auto index = WINDOW_SIZE - 1; index >= 0 && count < depth; --index)
+        {
+            const auto& level = ladder.levels[static_cast<size_t>(index)];
+            if (level.orders != 0)
+            {
+                visit(static_cast<Price>(ladder.base + index), level);
+            }
+        }
+        for (auto it = std::make_reverse_iterator(ladder.outside.lower_bound(static_cast<Price>(ladder.base)));
+             it != ladder.outside.rend() && count < depth; ++it)
+        {
+            visit(it->first, it->second);
+        }
+    }
+    else
+    {
+        for (auto it = ladder.outside.begin(); it != ladder.outside.end() && it->first < ladder.base && count < depth; ++it)
+        {
+            visit(it->first, it->second);
+        }
+        for (int64_t index = 0; index < WINDOW_SIZE && count < depth; ++index)
+        {
+            const auto& level = ladder.levels[static_cast<size_t>(index)];
+            if (level.orders != 0)
+            {
+                visit(static_cast<Price>(ladder.base + index), level);
+            }
+        }
+        for (auto it = ladder.outside.upper_bound(static_cast<Price>(windowEnd - 1)); it != ladder.outside.end() && count < depth; ++it)
+        {
+            visit(it->first, it->second);
+        }
+    }
+}
@@ -12,82 +12,29 @@ bool BuyOrderFinder::BuyOrder::operator>(const BuyOrder& another) const
     else return price > another.price;
 }
 
-void BuyOrderFinder::add(const Record& record)
+BuyOrderFinder::BuyOrderFinder()
+    : finder_{LIMIT}
 {
-    if (record.side != Side::BUY)
-    {
-        return;
-    }
-
-    switch (record.operation)
-    {
-        case Operation::INSERT:
-            addOrder(record);
-            break;
-
-        case Operation::CANCEL:
-            removeOrder(record);
-            break;
-
-        case Operation::AMEND:
-            removeOrder(record);
-            addOrder(record);
-            break;
-    }
 }
 
-std::vector<BuyOrderFinder::BuyOrder> BuyOrderFinder::biggestBuyOrders(const Symbol& symbol) const
+void BuyOrderFinder::add(const Record& record)
 {
-    std::vector<BuyOrderFinder::BuyOrder> result;
-
-    const auto orderDataIt = buyOrders_.find(symbol);
-    if (orderDataIt == buyOrders_.end())
-    {
-        return result;
-    }
-
-    const auto& sortedOrders = orderDataIt->second.sortedOrders;
-    auto it = sortedOrders.begin();
-    unsigned count = 0;
-
-    while (count < LIMIT && it != sortedOrders.end())
-    {
-        result.push_back(*it);
-        ++it;
-        ++count;
-    }
-
-    return result;
+    finder_.add(record);
 }
 
-void BuyOrderFinder::addOrder(const Record& record)
+void BuyOrderFinder::add(const RecordColumns& columns)
 {
-    auto& data = buyOrders_[record.symbol];
-
-    auto it = data.sortedOrders.insert(BuyOrder{record.ts, record.symbol, record.orderID, record.volume, record.price});
-    data.activeOrders[record.orderID] = it;
+    finder_.add(columns);
 }
 
-void BuyOrderFinder::removeOrder(const Record& record)
+std::vector<BuyOrderFinder::BuyOrder> BuyOrderFinder::biggestBuyOrders(const Symbol& symbol) const
 {
-    const auto symbolDataIt = buyOrders_.find(record.symbol);
-    if (symbolDataIt == buyOrders_.end())
-    {
-        return;
-    }
+    std::vector<BuyOrderFinder::BuyOrder> result;
 
-    auto& data = symbolDataIt->second;
-    const auto it = data.activeOrders.find(record.orderID);
-    if (it == data.activeOrders.end())
+    for (const auto& order : finder_.top(symbol))
     {
-        return;
+        result.push_back(BuyOrder{order.ts, order.symbol, order.orderID, order.volume, order.price});
     }
 
-    data.sortedOrders.erase(it->second);
-    data.activeOrders.erase(it);
-
-    if (data.activeOrders.empty())
-    {
-        buyOrders_.erase(symbolDataIt);
-    }
+    return result;
 }
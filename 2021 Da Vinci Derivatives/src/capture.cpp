@@ -0,0 +1,535 @@
+#include <capture.hpp>
+#include <flat_hash_map.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // Integers are stored in native (little-endian on all supported platforms) byte order.
+    constexpr std::array<char, 8> MAGIC = {'D', 'V', 'C', 'A', 'P', 'T', 'U', 'R'};
+    constexpr uint32_t VERSION = 1;
+
+    constexpr size_t HEADER_SIZE = MAGIC.size() + 2 * sizeof(uint32_t);
+    constexpr size_t TRAILER_SIZE = 2 * sizeof(uint64_t) + MAGIC.size();
+
+    constexpr size_t BLOCK_HEADER_SIZE = 2 * sizeof(uint32_t);
+    constexpr size_t INDEX_ENTRY_SIZE = sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    // five one-byte varints and the flags byte
+    constexpr size_t MIN_RECORD_SIZE = 6;
+
+    constexpr uint8_t SIDE_SHIFT = 2;
+    constexpr uint8_t OPERATION_MASK = (1 << SIDE_SHIFT) - 1;
+
+    template <typename T>
+    void putFixed(std::string& out, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    void putVarint(std::string& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    uint64_t zigzag(int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    class ByteReader final
+    {
+    public:
+        ByteReader(const char* begin, const char* end)
+            : current_{begin}
+            , end_{end}
+        {
+        }
+
+        template <typename T>
+        T fixed()
+        {
+            if (static_cast<size_t>(end_ - current_) < sizeof(T))
+            {
+                throw std::runtime_error("Malformed capture data");
+            }
+            T value;
+            std::memcpy(&value, current_, sizeof(T));
+            current_ += sizeof(T);
+            return value;
+        }
+
+        uint64_t varint()
+        {
+            uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                if (current_ == end_)
+                {
+                    break;
+                }
+                const auto byte = static_cast<uint8_t>(*current_++);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Malformed capture data");
+        }
+
+        uint8_t byte()
+        {
+            return fixed<uint8_t>();
+        }
+
+        size_t remaining() const
+        {
+            return static_cast<size_t>(end_ - current_);
+        }
+
+    private:
+        const char* current_;
+        const char* end_;
+    };
+
+    // Counts read from the file are checked before anything is allocated for them.
+    void checkCount(uint64_t count, size_t bytes, size_t elementSize)
+    {
+        if (count > bytes / elementSize)
+        {
+            throw std::runtime_error("Malformed capture data");
+        }
+    }
+
+    void checkMagic(const char* data)
+    {
+        if (std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0)
+        {
+            throw std::runtime_error("Not a capture file");
+        }
+    }
+}
+
+CaptureWriter::CaptureWriter(const std::string& filename, size_t blockSize)
+    : output_{filename, std::ios::binary | std::ios::trunc}
+    , blockSize_{std::max<size_t>(blockSize, 1)}
+{
+    if (!output_.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for writing.");
+    }
+
+    std::string header{MAGIC.begin(), MAGIC.end()};
+    putFixed<uint32_t>(header, VERSION);
+    putFixed<uint32_t>(header, 0);
+    output_.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    block_.reserve(blockSize_);
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    try
+    {
+        finish();
+    }
+    catch (...)
+    {
+    }
+}
+
+void CaptureWriter::add(const Record& record)
+{
+    if (finished_)
+    {
+        throw std::runtime_error("Capture is already finished");
+    }
+
+    block_.push_back(record);
+    if (block_.size() == blockSize_)
+    {
+        writeBlock();
+    }
+}
+
+void CaptureWriter::finish()
+{
+    if (finished_)
+    {
+        return;
+    }
+    finished_ = true;
+
+    writeBlock();
+
+    const auto indexOffset = static_cast<uint64_t>(output_.tellp());
+
+    std::string index;
+    for (const auto& block : index_)
+    {
+        putFixed<uint64_t>(index, block.offset);
+        putFixed<uint32_t>(index, block.records);
+        putFixed<uint64_t>(index, block.minTs);
+        putFixed<uint64_t>(index, block.maxTs);
+    }
+    putFixed<uint64_t>(index, indexOffset);
+    putFixed<uint64_t>(index, index_.size());
+    index.append(MAGIC.begin(), MAGIC.end());
+
+    output_.write(index.data(), static_cast<std::streamsize>(index.size()));
+    output_.close();
+    if (output_.fail())
+    {
+        throw std::runtime_error("Failed to write capture");
+    }
+}
+
+void CaptureWriter::writeBlock()
+{
+    if (block_.empty())
+    {
+        return;
+    }
+
+    std::string payload;
+
+    // symbol dictionary
+    FlatHashMap<Symbol, uint32_t> symbolCodes;
+    std::vector<Symbol> symbols;
+    for (const auto& record : block_)
+    {
+        if (symbolCodes.try_emplace(record.symbol, static_cast<uint32_t>(symbols.size())).second)
+        {
+            symbols.push_back(record.symbol);
+        }
+    }
+    putVarint(payload, symbols.size());
+    for (const auto symbol : symbols)
+    {
+        putFixed<Symbol>(payload, symbol);
+    }
+
+    // timestamps
+    Timestamp previousTs = 0;
+    for (const auto& record : block_)
+    {
+        putVarint(payload, zigzag(static_cast<int64_t>(record.ts - previousTs)));
+        previousTs = record.ts;
+    }
+
+    // symbols
+    for (const auto& record : block_)
+    {
+        putVarint(payload, symbolCodes[record.symbol]);
+    }
+
+    // order IDs
+    OrderID previousOrderID = 0;
+    for (const auto& record : block_)
+    {
+        putVarint(payload, zigzag(static_cast<int64_t>(record.orderID) - previousOrderID));
+        previousOrderID = record.orderID;
+    }
+
+    // volumes
+    for (const auto& record : block_)
+    {
+        putVarint(payload, record.volume);
+    }
+
+    // prices
+    Price previousPrice = 0;
+    for (const auto& record : block_)
+    {
+        putVarint(payload, zigzag(static_cast<int64_t>(record.price) - previousPrice));
+        previousPrice = record.price;
+    }
+
+    // operations and sides
+    for (const auto& record : block_)
+    {
+        payload.push_back(static_cast<char>(static_cast<uint8_t>(record.operation) |
+                                            static_cast<uint8_t>(record.side) << SIDE_SHIFT));
+    }
+
+    const auto [minIt, maxIt] = std::minmax_element(block_.begin(),
+                                                    block_.end(),
+                                                    [](const auto& a, const auto& b){ return a.ts < b.ts; });
+    index_.push_back(CaptureBlock{static_cast<uint64_t>(output_.tellp()),
+                                  static_cast<uint32_t>(block_.size()),
+                                  minIt->ts,
+                                  maxIt->ts});
+
+    std::string header;
+    putFixed<uint32_t>(header, static_cast<uint32_t>(block_.size()));
+    putFixed<uint32_t>(header, static_cast<uint32_t>(payload.size()));
+    output_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    output_.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+
+    block_.clear();
+}
+
+CaptureReader::CaptureReader(const std::string& filename)
+    : input_{filename, std::ios::binary}
+{
+    if (!input_.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for reading.");
+    }
+
+    input_.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(input_.tellg());
+    if (fileSize < HEADER_SIZE + TRAILER_SIZE)
+    {
+        throw std::runtime_error("Not a capture file");
+    }
+
+    // header
+    std::array<char, HEADER_SIZE> header;
+    input_.seekg(0);
+    input_.read(header.data(), header.size());
+    checkMagic(header.data());
+    ByteReader headerReader{header.data() + MAGIC.size(), header.data() + header.size()};
+    if (headerReader.fixed<uint32_t>() != VERSION)
+    {
+        throw std::runtime_error("Unsupported capture version");
+    }
+
+    // trailer
+    std::array<char, TRAILER_SIZE> trailer;
+    input_.seekg(static_cast<std::streamoff>(fileSize - TRAILER_SIZE));
+    input_.read(trailer.data(), trailer.size());
+    checkMagic(trailer.data() + 2 * sizeof(uint64_t));
+    ByteReader trailerReader{trailer.data(), trailer.data() + trailer.size()};
+    const auto indexOffset = trailerReader.fixed<uint64_t>();
+    const auto numberOfBlocks = trailerReader.fixed<uint64_t>();
+    if (indexOffset > fileSize - TRAILER_SIZE)
+    {
+        throw std::runtime_error("Malformed capture data");
+    }
+
+    // block index
+    std::vector<char> index(fileSize - TRAILER_SIZE - indexOffset);
+    input_.seekg(static_cast<std::streamoff>(indexOffset));
+    input_.read(index.data(), static_cast<std::streamsize>(index.size()));
+    if (!input_.good())
+    {
+        throw std::runtime_error("Failed to read capture index");
+    }
+
+    ByteReader indexReader{index.data(), index.data() + index.size()};
+    checkCount(numberOfBlocks, index.size(), INDEX_ENTRY_SIZE);
+    index_.reserve(numberOfBlocks);
+    for (uint64_t i = 0; i < numberOfBlocks; ++i)
+    {
+        CaptureBlock block;
+        block.offset = indexReader.fixed<uint64_t>();
+        block.records = indexReader.fixed<uint32_t>();
+        block.minTs = indexReader.fixed<uint64_t>();
+        block.maxTs = indexReader.fixed<uint64_t>();
+
+        // every block lies between the header and the index
+        if (block.offset < HEADER_SIZE || block.offset > indexOffset || indexOffset - block.offset < BLOCK_HEADER_SIZE)
+        {
+            throw std::runtime_error("Malformed capture data");
+        }
+        checkCount(block.records, indexOffset - block.offset - BLOCK_HEADER_SIZE, MIN_RECORD_SIZE);
+        index_.push_back(block);
+    }
+    dataEnd_ = indexOffset;
+}
+
+const std::vector<CaptureBlock>& CaptureReader::blocks() const
+{
+    return index_;
+}
+
+size_t CaptureReader::size() const
+{
+    size_t result = 0;
+    for (const auto& block : index_)
+    {
+        result += block.records;
+    }
+    return result;
+}
+
+std::vector<Record> CaptureReader::read()
+{
+    std::vector<Record> result;
+    result.reserve(size());
+    for (const auto& block : index_)
+    {
+        readBlock(block, result);
+    }
+    return result;
+}
+
+std::vector<Record> CaptureReader::read(Timestamp from, Timestamp to)
+{
+    RecordFilter filter;
+    filter.from = from;
+    filter.to = to;
+    return read(filter);
+}
+
+std::vector<Record> CaptureReader::read(const RecordFilter& filter)
+{
+    std::vector<Record> result;
+    for (const auto& block : index_)
+    {
+        if (block.maxTs < filter.from || block.minTs > filter.to)
+        {
+            if (filter.sortedByTime && block.minTs > filter.to)
+            {
+                break;
+            }
+            continue;
+        }
+
+        const auto blockBegin = result.size();
+        readBlock(block, result);
+        if (block.minTs < filter.from || block.maxTs > filter.to || !filter.symbols.empty())
+        {
+            const auto it = std::remove_if(result.begin() + static_cast<std::ptrdiff_t>(blockBegin),
+                                           result.end(),
+                                           [&filter](const auto& record)
+                                           {
+                                               return !filter.matchesTimestamp(record.ts) || !filter.matchesSymbol(record.symbol);
+                                           });
+            result.erase(it, result.end());
+        }
+    }
+    return result;
+}
+
+void CaptureReader::readBlock(const CaptureBlock& block, std::vector<Record>& records)
+{
+    std::array<char, BLOCK_HEADER_SIZE> header;
+    input_.clear();
+    input_.seekg(static_cast<std::streamoff>(block.offset));
+    input_.read(header.data(), header.size());
+
+    ByteReader headerReader{header.data(), header.data() + header.size()};
+    const auto numberOfRecords = headerReader.fixed<uint32_t>();
+    const auto payloadSize = headerReader.fixed<uint32_t>();
+    if (numberOfRecords != block.records || payloadSize > dataEnd_ - block.offset - BLOCK_HEADER_SIZE)
+    {
+        throw std::runtime_error("Malformed capture data");
+    }
+
+    buffer_.resize(payloadSize);
+    input_.read(buffer_.data(), payloadSize);
+    if (!input_.good())
+    {
+        throw std::runtime_error("Failed to read capture block");
+    }
+
+    ByteReader reader{buffer_.data(), buffer_.data() + buffer_.size()};
+
+    const auto numberOfSymbols = reader.varint();
+    checkCount(numberOfSymbols, reader.remaining(), sizeof(Symbol));
+    std::vector<Symbol> symbols(numberOfSymbols);
+    for (auto& symbol : symbols)
+    {
+        symbol = reader.fixed<Symbol>();
+    }
+
+    checkCount(numberOfRecords, reader.remaining(), MIN_RECORD_SIZE);
+    const auto first = records.size();
+    records.resize(first + numberOfRecords);
+    auto* output = records.data() + first;
+
+    Timestamp ts = 0;
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        ts += static_cast<Timestamp>(unzigzag(reader.varint()));
+        output[i].ts = ts;
+    }
+
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        const auto code = reader.varint();
+        if (code >= symbols.size())
+        {
+            throw std::runtime_error("Malformed capture data");
+        }
+        output[i].symbol = symbols[code];
+    }
+
+    int64_t orderID = 0;
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        orderID += unzigzag(reader.varint());
+        output[i].orderID = static_cast<OrderID>(orderID);
+    }
+
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        output[i].volume = static_cast<Volume>(reader.varint());
+    }
+
+    int64_t price = 0;
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        price += unzigzag(reader.varint());
+        output[i].price = static_cast<Price>(price);
+    }
+
+    for (uint32_t i = 0; i < numberOfRecords; ++i)
+    {
+        const auto flags = reader.byte();
+        const auto operation = flags & OPERATION_MASK;
+        const auto side = flags >> SIDE_SHIFT;
+        if (operation > static_cast<uint8_t>(Operation::AMEND) || side > static_cast<uint8_t>(Side::SELL))
+        {
+            records.resize(first);
+            throw std::runtime_error("Malformed capture data");
+        }
+        output[i].operation = static_cast<Operation>(operation);
+        output[i].side = static_cast<Side>(side);
+    }
+}
+
+void recordsToCapture(const std::vector<Record>& records, const std::string& filename)
+{
+    CaptureWriter writer{filename};
+    for (const auto& record : records)
+    {
+        writer.add(record);
+    }
+    writer.finish();
+}
+
+std::vector<Record> recordsFromCapture(const std::string& filename)
+{
+    CaptureReader reader{filename};
+    return reader.read();
+}
+
+std::vector<Record> recordsFromCapture(const std::string& filename, Timestamp from, Timestamp to)
+{
+    CaptureReader reader{filename};
+    return reader.read(from, to);
+}
+
+std::vector<Record> recordsFromCapture(const std::string& filename, const RecordFilter& filter)
+{
+    CaptureReader reader{filename};
+    return reader.read(filter);
+}
@@ -0,0 +1,136 @@
+#include <feed_follower.hpp>
+#include <parse.hpp>
+
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+}
+
+FeedFollower::FeedFollower(const std::string& filename)
+    : filename_{filename}
+    , input_{filename, std::ios::binary}
+{
+    if (!input_.good())
+    {
+        throw std::runtime_error("Failed to open file '" + filename + "' for reading.");
+    }
+
+#ifdef __linux__
+    notifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd_ < 0 || inotify_add_watch(notifyFd_, filename.c_str(), IN_MODIFY | IN_CLOSE_WRITE) < 0)
+    {
+        if (notifyFd_ >= 0)
+        {
+            close(notifyFd_);
+        }
+        throw std::runtime_error("Failed to watch file '" + filename + "'.");
+    }
+#endif
+
+    buffer_.resize(READ_CHUNK_SIZE);
+}
+
+FeedFollower::~FeedFollower()
+{
+#ifdef __linux__
+    close(notifyFd_);
+#endif
+}
+
+size_t FeedFollower::poll(const Callback& callback)
+{
+    // find out the current size of the file
+    input_.clear();
+    input_.seekg(0, std::ios::end);
+    const auto size = static_cast<uint64_t>(input_.tellg());
+    if (size < offset_)
+    {
+        offset_ = 0;
+    }
+
+    // an incomplete last line is read again by the next poll
+    size_t numberOfRecords = 0;
+    auto position = offset_;
+    partialLine_.clear();
+    input_.seekg(static_cast<std::streamoff>(position));
+
+    while (position < size)
+    {
+        const auto toRead = static_cast<std::streamsize>(std::min<uint64_t>(buffer_.size(), size - position));
+        input_.read(buffer_.data(), toRead);
+        const auto wasRead = input_.gcount();
+        if (wasRead <= 0)
+        {
+            break;
+        }
+        position += static_cast<uint64_t>(wasRead);
+
+        std::string_view chunk{buffer_.data(), static_cast<size_t>(wasRead)};
+        for (auto newLine = chunk.find('\n'); newLine != std::string_view::npos; newLine = chunk.find('\n'))
+        {
+            auto line = chunk.substr(0, newLine);
+            chunk.remove_prefix(newLine + 1);
+
+            if (!partialLine_.empty())
+            {
+                partialLine_.append(line.begin(), line.end());
+                line = partialLine_;
+            }
+
+            // the line is consumed even if it is malformed, so an error is reported only once
+            // and the lines after it are read by the next poll
+            offset_ = position - chunk.size();
+            if (!line.empty())
+            {
+                Record record;
+                try
+                {
+                    record = recordFromString(line);
+                }
+                catch (const std::exception& e)
+                {
+                    throw MalformedLineError("Malformed line '" + std::string{line} + "': " + e.what());
+                }
+                partialLine_.clear();
+                callback(record);
+                ++numberOfRecords;
+            }
+            partialLine_.clear();
+        }
+        partialLine_.append(chunk.begin(), chunk.end());
+    }
+
+    return numberOfRecords;
+}
+
+bool FeedFollower::wait(std::chrono::milliseconds timeout)
+{
+#ifdef __linux__
+    pollfd descriptor{notifyFd_, POLLIN, 0};
+    const auto result = ::poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    if (result <= 0)
+    {
+        return false;
+    }
+
+    // drain pending events, their content doesn't matter
+    alignas(inotify_event) char events[4096];
+    while (read(notifyFd_, events, sizeof(events)) > 0)
+    {
+    }
+    return true;
+#else
+    std::this_thread::sleep_for(timeout);
+    return true;
+#endif
+}
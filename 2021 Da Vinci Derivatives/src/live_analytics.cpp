@@ -0,0 +1,148 @@
+#include <live_analytics.hpp>
+
+#include <chrono>
+#include <utility>
+
+namespace
+{
+    // How long the background thread sleeps between checks of the stop flag.
+    constexpr std::chrono::milliseconds WAIT_TIMEOUT{100};
+}
+
+LiveAnalytics::LiveAnalytics(const std::string& filename)
+    : follower_{filename}
+{
+}
+
+LiveAnalytics::~LiveAnalytics()
+{
+    join();
+}
+
+size_t LiveAnalytics::update()
+{
+    batch_.clear();
+    try
+    {
+        follower_.poll([this](const Record& record){ batch_.push_back(record); });
+    }
+    catch (...)
+    {
+        // records before a malformed line are not lost
+        apply();
+        throw;
+    }
+
+    apply();
+    return batch_.size();
+}
+
+void LiveAnalytics::start()
+{
+    if (running_)
+    {
+        return;
+    }
+
+    join();
+    error_ = nullptr;
+    running_ = true;
+    thread_ = std::thread([this]{ run(); });
+}
+
+void LiveAnalytics::stop()
+{
+    join();
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+bool LiveAnalytics::isRunning() const
+{
+    return running_;
+}
+
+uint64_t LiveAnalytics::numberOfRecords() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numberOfRecords_;
+}
+
+uint64_t LiveAnalytics::numberOfMalformedLines() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numberOfMalformedLines_;
+}
+
+std::unordered_map<Symbol, uint32_t> LiveAnalytics::orderCounts() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counter_.orderCounts();
+}
+
+std::vector<BuyOrderFinder::BuyOrder> LiveAnalytics::biggestBuyOrders(const Symbol& symbol) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buyFinder_.biggestBuyOrders(symbol);
+}
+
+std::optional<SellOrderFinder::SellPosition> LiveAnalytics::bestSellAtTime(const Symbol& symbol, const Timestamp& ts) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sellFinder_.bestSellAtTime(symbol, ts);
+}
+
+void LiveAnalytics::run()
+{
+    try
+    {
+        while (running_)
+        {
+            try
+            {
+                update();
+            }
+            catch (const MalformedLineError&)
+            {
+                // the lines after it may be already there
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++numberOfMalformedLines_;
+                continue;
+            }
+            follower_.wait(WAIT_TIMEOUT);
+        }
+    }
+    catch (...)
+    {
+        error_ = std::current_exception();
+        running_ = false;
+    }
+}
+
+void LiveAnalytics::apply()
+{
+    if (batch_.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& record : batch_)
+    {
+        counter_.add(record);
+        buyFinder_.add(record);
+        sellFinder_.add(record);
+    }
+    numberOfRecords_ += batch_.size();
+}
+
+void LiveAnalytics::join()
+{
+    running_ = false;
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
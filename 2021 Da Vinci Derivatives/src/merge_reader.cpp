@@ -0,0 +1,125 @@
+#include <merge_reader.hpp>
+#include <parse.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    std::vector<MergeSource> toSources(const std::vector<std::string>& filenames)
+    {
+        std::vector<MergeSource> result;
+        result.reserve(filenames.size());
+        for (const auto& filename : filenames)
+        {
+            result.push_back({filename, 0});
+        }
+        return result;
+    }
+
+    template <typename Sources>
+    std::vector<Record> readAll(const Sources& sources)
+    {
+        MergeReader reader{sources};
+
+        std::vector<Record> result;
+        while (const auto record = reader.next())
+        {
+            result.push_back(*record);
+        }
+        return result;
+    }
+}
+
+MergeReader::MergeReader(const std::vector<std::string>& filenames, size_t readAhead)
+    : MergeReader{toSources(filenames), readAhead}
+{
+}
+
+MergeReader::MergeReader(const std::vector<MergeSource>& sources, size_t readAhead)
+    : readAhead_{std::max<size_t>(readAhead, 1)}
+    , sources_(sources.size())
+{
+    heap_.reserve(sources.size());
+
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        auto& source = sources_[i];
+        source.source = sources[i];
+        source.input.open(source.source.filename);
+        if (!source.input.good())
+        {
+            throw std::runtime_error("Failed to open file '" + source.source.filename + "' for reading.");
+        }
+        source.buffer.reserve(readAhead_);
+
+        if (refill(source))
+        {
+            pushHead(i);
+        }
+    }
+}
+
+std::optional<Record> MergeReader::next()
+{
+    if (heap_.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    const auto index = heap_.back().source;
+    heap_.pop_back();
+
+    auto& source = sources_[index];
+    const auto result = source.buffer[source.position++];
+
+    if (source.position < source.buffer.size() || refill(source))
+    {
+        pushHead(index);
+    }
+
+    return result;
+}
+
+bool MergeReader::refill(Source& source)
+{
+    source.buffer.clear();
+    source.position = 0;
+
+    while (source.buffer.size() < readAhead_ && std::getline(source.input, line_))
+    {
+        auto record = recordFromString(line_);
+        record.ts += source.source.tsOffset;
+        if (record.ts < source.lastTs)
+        {
+            throw std::runtime_error("File '" + source.source.filename + "' is not sorted by timestamp.");
+        }
+        source.lastTs = record.ts;
+        source.buffer.push_back(record);
+    }
+
+    return !source.buffer.empty();
+}
+
+void MergeReader::pushHead(size_t index)
+{
+    const auto& source = sources_[index];
+    heap_.push_back({source.buffer[source.position].ts, index});
+    std::push_heap(heap_.begin(), heap_.end(), later);
+}
+
+bool MergeReader::later(const Head& a, const Head& b)
+{
+    return a.ts != b.ts ? a.ts > b.ts : a.source > b.source;
+}
+
+std::vector<Record> recordsFromFiles(const std::vector<std::string>& filenames)
+{
+    return readAll(filenames);
+}
+
+std::vector<Record> recordsFromFiles(const std::vector<MergeSource>& sources)
+{
+    return readAll(sources);
+}
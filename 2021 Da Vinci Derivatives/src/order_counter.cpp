@@ -6,33 +6,11 @@ void OrderCounter::add(const Record& record)
     switch (record.operation)
     {
         case Operation::INSERT:
-            {
-                auto& orders = activeOrders_[record.symbol];
-                orders.insert(record.orderID);
-                numberOfOrders_[record.symbol] = static_cast<uint32_t>(orders.size());
-            }
+            insertOrder(record.symbol, record.orderID);
             break;
 
         case Operation::CANCEL:
-            {
-                auto it = activeOrders_.find(record.symbol);
-                if (it == activeOrders_.end())
-                {
-                    break;
-                }
-
-                auto& orders = it->second;
-                orders.erase(record.orderID);
-                if (orders.empty())
-                {
-                    activeOrders_.erase(record.symbol);
-                    numberOfOrders_.erase(record.symbol);
-                }
-                else
-                {
-                    numberOfOrders_[record.symbol] = static_cast<uint32_t>(orders.size());
-                }
-            }
+            cancelOrder(record.symbol, record.orderID);
             break;
 
         default:
@@ -40,7 +18,57 @@ void OrderCounter::add(const Record& record)
     }
 }
 
+void OrderCounter::add(const RecordColumns& columns)
+{
+    // only operation, symbol and order ID columns are read, records are never rebuilt
+    const auto& operations = columns.operations();
+    const auto& orderIDs = columns.orderIDs();
+    for (size_t row = 0; row < operations.size(); ++row)
+    {
+        switch (operations[row])
+        {
+            case Operation::INSERT:
+                insertOrder(columns.symbol(row), orderIDs[row]);
+                break;
+
+            case Operation::CANCEL:
+                cancelOrder(columns.symbol(row), orderIDs[row]);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 std::unordered_map<Symbol, uint32_t> OrderCounter::orderCounts() const
 {
-    return numberOfOrders_;
+    std::unordered_map<Symbol, uint32_t> result;
+    result.reserve(activeOrders_.size());
+    for (const auto& [symbol, orders] : activeOrders_)
+    {
+        result[symbol] = static_cast<uint32_t>(orders.size());
+    }
+    return result;
+}
+
+void OrderCounter::insertOrder(const Symbol& symbol, OrderID orderID)
+{
+    activeOrders_[symbol].insert(orderID);
+}
+
+void OrderCounter::cancelOrder(const Symbol& symbol, OrderID orderID)
+{
+    auto it = activeOrders_.find(symbol);
+    if (it == activeOrders_.end())
+    {
+        return;
+    }
+
+    auto& orders = it->second;
+    orders.erase(orderID);
+    if (orders.empty())
+    {
+        activeOrders_.erase(it);
+    }
 }
@@ -56,6 +56,52 @@ namespace
         }
         return result + 1;
     }
+
+    std::ifstream openFile(const std::string& filename)
+    {
+        std::ifstream input(filename);
+        if (!input.good())
+        {
+            throw std::runtime_error("Failed to open file '" + filename + "' for reading.");
+        }
+        return input;
+    }
+
+    enum class FilterResult
+    {
+        MATCH,
+        SKIP,
+        STOP
+    };
+
+    FilterResult applyFilter(const std::string_view& recordString, const RecordFilter& filter)
+    {
+        if (recordString.size() <= SYMBOL_OFFSET)
+        {
+            // let the full parser complain about it
+            return FilterResult::MATCH;
+        }
+
+        const auto ts = timestampFromString({recordString.data(), SYMBOL_OFFSET - 1});
+        if (!filter.matchesTimestamp(ts))
+        {
+            return filter.sortedByTime && ts > filter.to ? FilterResult::STOP : FilterResult::SKIP;
+        }
+
+        if (filter.symbols.empty())
+        {
+            return FilterResult::MATCH;
+        }
+
+        const auto symbolEnd = recordString.find(DELIMITER, SYMBOL_OFFSET);
+        if (symbolEnd == std::string_view::npos || symbolEnd - SYMBOL_OFFSET > sizeof(Symbol))
+        {
+            return FilterResult::MATCH;
+        }
+
+        const auto symbol = symbolFromString(recordString.substr(SYMBOL_OFFSET, symbolEnd - SYMBOL_OFFSET));
+        return filter.matchesSymbol(symbol) ? FilterResult::MATCH : FilterResult::SKIP;
+    }
 }
 
 Timestamp timestampFromString(const std::string_view& tsString)
@@ -204,11 +250,31 @@ std::vector<Record> recordsFromStream(std::istream& stream)
 
 std::vector<Record> recordsFromFile(const std::string& filename)
 {
-    std::ifstream input(filename);
-    if (!input.good())
+    auto input = openFile(filename);
+    return recordsFromStream(input);
+}
+
+std::vector<Record> recordsFromStream(std::istream& stream, const RecordFilter& filter)
+{
+    std::vector<Record> result;
+    for (std::string line; std::getline(stream, line);)
     {
-        throw std::runtime_error("Failed to open file '" + filename + "' for reading.");
+        const auto filterResult = applyFilter(line, filter);
+        if (filterResult == FilterResult::STOP)
+        {
+            break;
+        }
+        if (filterResult == FilterResult::MATCH)
+        {
+            result.push_back(recordFromString(line));
+        }
     }
-    return recordsFromStream(input);
+    return result;
+}
+
+std::vector<Record> recordsFromFile(const std::string& filename, const RecordFilter& filter)
+{
+    auto input = openFile(filename);
+    return recordsFromStream(input, filter);
 }
 
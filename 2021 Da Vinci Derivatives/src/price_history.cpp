@@ -0,0 +1,156 @@
+#include <price_history.hpp>
+
+#include <algorithm>
+
+namespace
+{
+    void putVarint(std::vector<uint8_t>& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Data is written by this process, so there are no bounds checks.
+    uint64_t getVarint(const uint8_t* data, size_t& offset)
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7)
+        {
+            const auto byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+    }
+
+    uint64_t zigzag(int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Decodes the entry following previous, offset is moved past it.
+    PriceHistory::Entry decodeEntry(const uint8_t* data, size_t& offset, const PriceHistory::Entry& previous)
+    {
+        PriceHistory::Entry result;
+        result.ts = previous.ts + getVarint(data, offset);
+        result.price = static_cast<Price>(previous.price + unzigzag(getVarint(data, offset)));
+        result.volume = static_cast<Volume>(getVarint(data, offset));
+        return result;
+    }
+}
+
+PriceHistory::Cursor::Cursor(const PriceHistory& history)
+    : history_{history}
+{
+    hasNext_ = decodeNext();
+}
+
+const PriceHistory::Entry* PriceHistory::Cursor::advance(Timestamp ts)
+{
+    while (hasNext_ && next_.ts <= ts)
+    {
+        current_ = next_;
+        hasCurrent_ = true;
+        hasNext_ = decodeNext();
+    }
+    return hasCurrent_ ? &current_ : nullptr;
+}
+
+bool PriceHistory::Cursor::decodeNext()
+{
+    if (index_ == history_.size_)
+    {
+        return false;
+    }
+
+    auto previous = next_;
+    if (index_ % BLOCK_SIZE == 0)
+    {
+        const auto& block = history_.blocks_[index_ / BLOCK_SIZE];
+        previous = Entry{block.ts, block.price, 0};
+        offset_ = block.offset;
+    }
+
+    next_ = decodeEntry(history_.data_.data(), offset_, previous);
+    ++index_;
+    return true;
+}
+
+void PriceHistory::add(const Entry& entry)
+{
+    auto previous = last_;
+    if (size_ % BLOCK_SIZE == 0)
+    {
+        blocks_.push_back(Block{entry.ts, entry.price, data_.size()});
+        previous = Entry{entry.ts, entry.price, 0};
+    }
+
+    putVarint(data_, entry.ts - previous.ts);
+    putVarint(data_, zigzag(static_cast<int64_t>(entry.price) - previous.price));
+    putVarint(data_, entry.volume);
+
+    last_ = entry;
+    ++size_;
+}
+
+bool PriceHistory::empty() const
+{
+    return size_ == 0;
+}
+
+size_t PriceHistory::size() const
+{
+    return size_;
+}
+
+const PriceHistory::Entry& PriceHistory::back() const
+{
+    return last_;
+}
+
+std::optional<PriceHistory::Entry> PriceHistory::at(Timestamp ts) const
+{
+    // the last block starting not later than ts
+    const auto blockIt = std::upper_bound(blocks_.begin(),
+                                          blocks_.end(),
+                                          ts,
+                                          [](Timestamp a, const Block& b){ return a < b.ts; });
+    if (blockIt == blocks_.begin())
+    {
+        return std::nullopt;
+    }
+
+    const auto blockIndex = static_cast<size_t>(blockIt - blocks_.begin()) - 1;
+    const auto& block = blocks_[blockIndex];
+    const auto entries = std::min(BLOCK_SIZE, size_ - blockIndex * BLOCK_SIZE);
+
+    auto offset = block.offset;
+    auto result = decodeEntry(data_.data(), offset, Entry{block.ts, block.price, 0});
+    for (size_t i = 1; i < entries; ++i)
+    {
+        const auto entry = decodeEntry(data_.data(), offset, result);
+        if (entry.ts > ts)
+        {
+            break;
+        }
+        result = entry;
+    }
+
+    return result;
+}
+
+size_t PriceHistory::memoryUsage() const
+{
+    return data_.capacity() * sizeof(uint8_t) + blocks_.capacity() * sizeof(Block);
+}
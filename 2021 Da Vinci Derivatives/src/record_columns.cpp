@@ -0,0 +1,206 @@
+#include <record_columns.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // A new timestamp block is started at least every that many rows,
+    // so random access never has to go far from a block base.
+    constexpr size_t TIMESTAMP_BLOCK_SIZE = 1024;
+
+    constexpr Timestamp MAX_TIMESTAMP_OFFSET = std::numeric_limits<uint32_t>::max();
+}
+
+RecordColumns::RecordColumns(Encoding encoding)
+    : encoding_{encoding}
+{
+}
+
+RecordColumns::RecordColumns(const std::vector<Record>& records, Encoding encoding)
+    : encoding_{encoding}
+{
+    reserve(records.size());
+    for (const auto& record : records)
+    {
+        push_back(record);
+    }
+}
+
+void RecordColumns::reserve(size_t size)
+{
+    if (encoding_.offsetTimestamps)
+    {
+        timestampOffsets_.reserve(size);
+    }
+    else
+    {
+        timestamps_.reserve(size);
+    }
+
+    if (encoding_.dictionarySymbols)
+    {
+        symbolCodes_.reserve(size);
+    }
+    else
+    {
+        symbols_.reserve(size);
+    }
+
+    orderIDs_.reserve(size);
+    volumes_.reserve(size);
+    prices_.reserve(size);
+    operations_.reserve(size);
+    sides_.reserve(size);
+}
+
+void RecordColumns::push_back(const Record& record)
+{
+    pushTimestamp(record.ts);
+    pushSymbol(record.symbol);
+    orderIDs_.push_back(record.orderID);
+    volumes_.push_back(record.volume);
+    prices_.push_back(record.price);
+    operations_.push_back(record.operation);
+    sides_.push_back(record.side);
+}
+
+size_t RecordColumns::size() const
+{
+    return orderIDs_.size();
+}
+
+bool RecordColumns::empty() const
+{
+    return orderIDs_.empty();
+}
+
+const RecordColumns::Encoding& RecordColumns::encoding() const
+{
+    return encoding_;
+}
+
+Timestamp RecordColumns::timestamp(size_t row) const
+{
+    if (!encoding_.offsetTimestamps)
+    {
+        return timestamps_[row];
+    }
+    return timestampBlocks_[timestampBlock(row)].base + timestampOffsets_[row];
+}
+
+Symbol RecordColumns::symbol(size_t row) const
+{
+    return encoding_.dictionarySymbols ? symbolDictionary_[symbolCodes_[row]] : symbols_[row];
+}
+
+Record RecordColumns::record(size_t row) const
+{
+    return record(row, encoding_.offsetTimestamps ? timestampBlock(row) : 0);
+}
+
+const std::vector<OrderID>& RecordColumns::orderIDs() const
+{
+    return orderIDs_;
+}
+
+const std::vector<Volume>& RecordColumns::volumes() const
+{
+    return volumes_;
+}
+
+const std::vector<Price>& RecordColumns::prices() const
+{
+    return prices_;
+}
+
+const std::vector<Operation>& RecordColumns::operations() const
+{
+    return operations_;
+}
+
+const std::vector<Side>& RecordColumns::sides() const
+{
+    return sides_;
+}
+
+const std::vector<Symbol>& RecordColumns::symbolDictionary() const
+{
+    return symbolDictionary_;
+}
+
+std::vector<uint32_t> RecordColumns::rowsWithSide(Side side) const
+{
+    std::vector<uint32_t> result(sides_.size());
+
+    // branchless selection: every row is written, but only matching ones are kept
+    const auto* sides = sides_.data();
+    auto* rows = result.data();
+    size_t count = 0;
+    for (size_t row = 0; row < sides_.size(); ++row)
+    {
+        rows[count] = static_cast<uint32_t>(row);
+        count += (sides[row] == side);
+    }
+
+    result.resize(count);
+    return result;
+}
+
+void RecordColumns::pushTimestamp(Timestamp ts)
+{
+    if (!encoding_.offsetTimestamps)
+    {
+        timestamps_.push_back(ts);
+        return;
+    }
+
+    const auto row = timestampOffsets_.size();
+    if (timestampBlocks_.empty() ||
+        row - timestampBlocks_.back().firstRow >= TIMESTAMP_BLOCK_SIZE ||
+        ts < timestampBlocks_.back().base ||
+        ts - timestampBlocks_.back().base > MAX_TIMESTAMP_OFFSET)
+    {
+        timestampBlocks_.push_back(TimestampBlock{row, ts});
+    }
+
+    timestampOffsets_.push_back(static_cast<uint32_t>(ts - timestampBlocks_.back().base));
+}
+
+void RecordColumns::pushSymbol(Symbol symbol)
+{
+    if (!encoding_.dictionarySymbols)
+    {
+        symbols_.push_back(symbol);
+        return;
+    }
+
+    const auto [it, inserted] = symbolIndex_.try_emplace(symbol, static_cast<uint32_t>(symbolDictionary_.size()));
+    if (inserted)
+    {
+        symbolDictionary_.push_back(symbol);
+    }
+    symbolCodes_.push_back(it->second);
+}
+
+size_t RecordColumns::timestampBlock(size_t row) const
+{
+    const auto it = std::upper_bound(timestampBlocks_.begin(),
+                                     timestampBlocks_.end(),
+                                     row,
+                                     [](size_t r, const auto& block){ return r < block.firstRow; });
+    return static_cast<size_t>(it - timestampBlocks_.begin()) - 1;
+}
+
+Record RecordColumns::record(size_t row, size_t block) const
+{
+    Record result;
+    result.ts = encoding_.offsetTimestamps ? timestampBlocks_[block].base + timestampOffsets_[row] : timestamps_[row];
+    result.symbol = symbol(row);
+    result.orderID = orderIDs_[row];
+    result.volume = volumes_[row];
+    result.price = prices_[row];
+    result.operation = operations_[row];
+    result.side = sides_[row];
+    return result;
+}
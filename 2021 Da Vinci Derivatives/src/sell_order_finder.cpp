@@ -1,11 +1,22 @@
 #include <sell_order_finder.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <stdexcept>
+#include <thread>
 
 namespace
 {
     constexpr Price IMPOSSIBLE_PRICE = std::numeric_limits<Price>::min();
+
+    void checkSorted(const std::vector<Timestamp>& sortedTs)
+    {
+        if (!std::is_sorted(sortedTs.begin(), sortedTs.end()))
+        {
+            throw std::runtime_error("Timestamps must be sorted");
+        }
+    }
 }
 
 void SellOrderFinder::add(const Record& record)
@@ -22,16 +33,40 @@ void SellOrderFinder::add(const Record& record)
             break;
 
         case Operation::CANCEL:
-            removeOrder(record, true);
+            removeOrder(record.symbol, record.orderID, record.ts, true);
             break;
 
         case Operation::AMEND:
-            removeOrder(record, false);
+            removeOrder(record.symbol, record.orderID, record.ts, false);
             addOrder(record);
             break;
     }
 }
 
+void SellOrderFinder::add(const RecordColumns& columns)
+{
+    const auto& operations = columns.operations();
+    const auto& orderIDs = columns.orderIDs();
+    for (const auto row : columns.rowsWithSide(Side::SELL))
+    {
+        switch (operations[row])
+        {
+            case Operation::INSERT:
+                addOrder(columns.record(row));
+                break;
+
+            case Operation::CANCEL:
+                removeOrder(columns.symbol(row), orderIDs[row], columns.timestamp(row), true);
+                break;
+
+            case Operation::AMEND:
+                removeOrder(columns.symbol(row), orderIDs[row], columns.timestamp(row), false);
+                addOrder(columns.record(row));
+                break;
+        }
+    }
+}
+
 std::optional<SellOrderFinder::SellPosition> SellOrderFinder::bestSellAtTime(const Symbol& symbol, const Timestamp& ts) const
 {
     std::optional<SellPosition> result;
@@ -42,15 +77,95 @@ std::optional<SellOrderFinder::SellPosition> SellOrderFinder::bestSellAtTime(con
         return result;
     }
 
-    const auto& priceHistory = orderDataIt->second.priceHistory;
+    const auto entry = orderDataIt->second.priceHistory.at(ts);
+    if (entry && entry->price != IMPOSSIBLE_PRICE)
+    {
+        result = SellPosition{entry->price, entry->volume};
+    }
+
+    return result;
+}
+
+std::vector<std::optional<SellOrderFinder::SellPosition>> SellOrderFinder::bestSellAtTimes(const Symbol& symbol,
+                                                                                          const std::vector<Timestamp>& sortedTs) const
+{
+    checkSorted(sortedTs);
+
+    const auto orderDataIt = sellOrders_.find(symbol);
+    if (orderDataIt == sellOrders_.end())
+    {
+        return std::vector<std::optional<SellPosition>>(sortedTs.size());
+    }
+
+    return sweepHistory(orderDataIt->second.priceHistory, sortedTs);
+}
+
+std::unordered_map<Symbol, std::vector<std::optional<SellOrderFinder::SellPosition>>>
+SellOrderFinder::bestSellAtTimes(const std::vector<Timestamp>& sortedTs, size_t numberOfThreads) const
+{
+    checkSorted(sortedTs);
+
+    std::vector<const std::pair<Symbol, SellOrdersData>*> symbols;
+    symbols.reserve(sellOrders_.size());
+    for (const auto& symbolData : sellOrders_)
+    {
+        symbols.push_back(&symbolData);
+    }
+
+    // every thread takes the next not yet processed symbol
+    std::vector<std::vector<std::optional<SellPosition>>> results(symbols.size());
+    std::atomic<size_t> nextSymbol{0};
+    const auto worker = [&]()
+    {
+        for (auto i = nextSymbol++; i < symbols.size(); i = nextSymbol++)
+        {
+            results[i] = sweepHistory(symbols[i]->second.priceHistory, sortedTs);
+        }
+    };
+
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numberOfThreads = std::min(numberOfThreads, symbols.size());
 
-    const auto it = std::lower_bound(priceHistory.rbegin(),
-                                     priceHistory.rend(),
-                                     ts,
-                                     [](const auto& a, const auto& b){ return a.ts > b; });
-    if (it != priceHistory.rend() && it->price != IMPOSSIBLE_PRICE)
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numberOfThreads; ++i)
     {
-        result = SellPosition{it->price, it->volume};
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::unordered_map<Symbol, std::vector<std::optional<SellPosition>>> result;
+    for (size_t i = 0; i < symbols.size(); ++i)
+    {
+        result.emplace(symbols[i]->first, std::move(results[i]));
+    }
+    return result;
+}
+
+std::vector<std::optional<SellOrderFinder::SellPosition>> SellOrderFinder::sweepHistory(const PriceHistory& priceHistory,
+                                                                                       const std::vector<Timestamp>& sortedTs)
+{
+    std::vector<std::optional<SellPosition>> result;
+    result.reserve(sortedTs.size());
+
+    PriceHistory::Cursor cursor{priceHistory};
+    for (const auto ts : sortedTs)
+    {
+        const auto entry = cursor.advance(ts);
+        if (entry && entry->price != IMPOSSIBLE_PRICE)
+        {
+            result.emplace_back(SellPosition{entry->price, entry->volume});
+        }
+        else
+        {
+            result.emplace_back();
+        }
     }
 
     return result;
@@ -67,14 +182,14 @@ void SellOrderFinder::addOrder(const Record& record)
         data.priceHistory.back().price != data.activePrices.begin()->first ||
         data.priceHistory.back().volume != data.activePrices.begin()->second)
     {
-        data.priceHistory.push_back(HistoryRecord{record.ts, data.activePrices.begin()->first, data.activePrices.begin()->second});
+        data.priceHistory.add({record.ts, data.activePrices.begin()->first, data.activePrices.begin()->second});
     }
 }
 
-void SellOrderFinder::removeOrder(const Record& record, bool updateHistory)
+void SellOrderFinder::removeOrder(const Symbol& symbol, OrderID orderID, Timestamp ts, bool updateHistory)
 {
     // check if symbol is known
-    const auto symbolDataIt = sellOrders_.find(record.symbol);
+    const auto symbolDataIt = sellOrders_.find(symbol);
     if (symbolDataIt == sellOrders_.end())
     {
         return;
@@ -83,7 +198,7 @@ void SellOrderFinder::removeOrder(const Record& record, bool updateHistory)
     auto& data = symbolDataIt->second;
 
     // check is order is known
-    const auto orderDataIt = data.activeOrders.find(record.orderID);
+    const auto orderDataIt = data.activeOrders.find(orderID);
     if (orderDataIt == data.activeOrders.end())
     {
         return;
@@ -104,12 +219,12 @@ void SellOrderFinder::removeOrder(const Record& record, bool updateHistory)
     {
         if (data.activePrices.empty())
         {
-            data.priceHistory.push_back(HistoryRecord{record.ts, IMPOSSIBLE_PRICE, 0});
+            data.priceHistory.add({ts, IMPOSSIBLE_PRICE, 0});
         }
         else if (data.priceHistory.back().price != data.activePrices.begin()->first ||
                  data.priceHistory.back().volume != data.activePrices.begin()->second)
         {
-            data.priceHistory.push_back(HistoryRecord{record.ts, data.activePrices.begin()->first, data.activePrices.begin()->second});
+            data.priceHistory.add({ts, data.activePrices.begin()->first, data.activePrices.begin()->second});
         }
     }
 
@@ -0,0 +1,201 @@
+#include "feed_generator.hpp"
+
+#include <flat_hash_map.hpp>
+#include <parse.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    const Timestamp START_TS = timestampFromString("08:00:00.000000");
+    constexpr Timestamp MAX_TS_STEP = 200;
+
+    constexpr Price START_PRICE = 1000;
+    constexpr Price MIN_PRICE = 10;
+    constexpr Price MAX_PRICE_STEP = 2;
+    constexpr Price MAX_SPREAD = 20;
+
+    constexpr Volume MAX_VOLUME = 1000;
+
+    // Symbols are named "SYM<n>" and have to fit into 8 characters.
+    constexpr size_t MAX_SYMBOLS = 100000;
+
+    const char* const OPERATIONS[] = {"I", "C", "A"};
+    const char* const SIDES[] = {"BUY", "SELL"};
+
+    class Generator final
+    {
+    public:
+        explicit Generator(const FeedConfig& config)
+            : config_{config}
+            , random_{config.seed}
+        {
+            if (config.symbols == 0 || config.symbols > MAX_SYMBOLS)
+            {
+                throw std::runtime_error("Number of symbols must be in [1, " + std::to_string(MAX_SYMBOLS) + "]");
+            }
+            if (config.orderLifetime == 0)
+            {
+                throw std::runtime_error("Order lifetime must be positive");
+            }
+            if (config.amendShare < 0 || config.amendShare >= 1 || config.cancelShare < 0 || config.cancelShare > 1)
+            {
+                throw std::runtime_error("Amend share must be in [0, 1), cancel share in [0, 1]");
+            }
+
+            for (size_t i = 0; i < config.symbols; ++i)
+            {
+                symbols_.push_back(symbolFromString("SYM" + std::to_string(i)));
+                symbolIndexes_[symbols_.back()] = i;
+            }
+            prices_.assign(config.symbols, START_PRICE);
+        }
+
+        std::vector<Record> generate()
+        {
+            std::vector<Record> result;
+            result.reserve(config_.records);
+
+            for (size_t step = 0; step < config_.records; ++step)
+            {
+                ts_ += std::uniform_int_distribution<Timestamp>{0, MAX_TS_STEP}(random_);
+
+                if (!expiries_.empty() && expiries_.top().first <= step)
+                {
+                    result.push_back(cancel(expiries_.top().second));
+                    expiries_.pop();
+                }
+                else if (!active_.empty() && chance(config_.amendShare))
+                {
+                    result.push_back(amend(active_[index(active_.size())]));
+                }
+                else
+                {
+                    result.push_back(insert(step));
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        bool chance(double probability)
+        {
+            return std::uniform_real_distribution<double>{0, 1}(random_) < probability;
+        }
+
+        size_t index(size_t size)
+        {
+            return std::uniform_int_distribution<size_t>{0, size - 1}(random_);
+        }
+
+        void priceAndVolume(Record& record)
+        {
+            auto& mid = prices_[symbolIndexes_[record.symbol]];
+            mid = std::max(MIN_PRICE + MAX_SPREAD, mid + std::uniform_int_distribution<Price>{-MAX_PRICE_STEP, MAX_PRICE_STEP}(random_));
+
+            const auto spread = std::uniform_int_distribution<Price>{1, MAX_SPREAD}(random_);
+            record.price = record.side == Side::BUY ? mid - spread : mid + spread;
+            record.volume = std::uniform_int_distribution<Volume>{1, MAX_VOLUME}(random_);
+        }
+
+        Record insert(size_t step)
+        {
+            Record record;
+            record.ts = ts_;
+            record.symbol = symbols_[index(symbols_.size())];
+            record.orderID = ++lastOrderID_;
+            record.operation = Operation::INSERT;
+            record.side = chance(0.5) ? Side::BUY : Side::SELL;
+            priceAndVolume(record);
+
+            positions_[record.orderID] = active_.size();
+            active_.push_back(record);
+
+            if (chance(config_.cancelShare))
+            {
+                const auto lifetime = std::exponential_distribution<double>{1.0 / static_cast<double>(config_.orderLifetime)}(random_);
+                expiries_.push({step + 1 + static_cast<size_t>(lifetime), record.orderID});
+            }
+
+            return record;
+        }
+
+        Record amend(Record& order)
+        {
+            order.ts = ts_;
+            priceAndVolume(order);
+
+            auto record = order;
+            record.operation = Operation::AMEND;
+            return record;
+        }
+
+        Record cancel(OrderID orderID)
+        {
+            const auto position = positions_.find(orderID)->second;
+            auto record = active_[position];
+            record.ts = ts_;
+            record.operation = Operation::CANCEL;
+
+            active_[position] = active_.back();
+            positions_[active_[position].orderID] = position;
+            active_.pop_back();
+            positions_.erase(orderID);
+
+            return record;
+        }
+
+    private:
+        using Expiry = std::pair<size_t, OrderID>;
+
+        const FeedConfig& config_;
+        std::mt19937_64 random_;
+
+        std::vector<Symbol> symbols_;
+        FlatHashMap<Symbol, size_t> symbolIndexes_;
+        std::vector<Price> prices_;
+
+        Timestamp ts_ = START_TS;
+        OrderID lastOrderID_ = 0;
+
+        std::vector<Record> active_;
+        FlatHashMap<OrderID, size_t> positions_;
+        std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> expiries_;
+    };
+}
+
+std::vector<Record> generateFeed(const FeedConfig& config)
+{
+    return Generator{config}.generate();
+}
+
+std::string feedToString(const std::vector<Record>& records)
+{
+    std::string result;
+    for (const auto& record : records)
+    {
+        result += timestampToString(record.ts);
+        result += ';';
+        result += symbolToString(record.symbol);
+        result += ';';
+        result += std::to_string(record.orderID);
+        result += ';';
+        result += OPERATIONS[static_cast<size_t>(record.operation)];
+        result += ';';
+        result += SIDES[static_cast<size_t>(record.side)];
+        result += ';';
+        result += std::to_string(record.volume);
+        result += ';';
+        result += std::to_string(record.price / 10);
+        result += '.';
+        result += std::to_string(record.price % 10);
+        result += '\n';
+    }
+    return result;
+}
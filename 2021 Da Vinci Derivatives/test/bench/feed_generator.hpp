@@ -0,0 +1,30 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+struct FeedConfig
+{
+    uint64_t seed = 1;
+    size_t records = 1000000;
+    size_t symbols = 10;
+    // Mean number of records between insert and cancel of a cancelled order.
+    size_t orderLifetime = 1000;
+    // Share of records which amend an active order.
+    double amendShare = 0.2;
+    // Share of inserted orders which are cancelled later, others stay active.
+    double cancelShare = 0.9;
+};
+
+
+// Generates a synthetic feed sorted by timestamp, the same config always
+// produces the same feed.
+std::vector<Record> generateFeed(const FeedConfig& config);
+
+// Formats records as lines of a data file.
+std::string feedToString(const std::vector<Record>& records);
@@ -0,0 +1,320 @@
+#include "feed_generator.hpp"
+
+#include <bar_aggregator.hpp>
+#include <book_builder.hpp>
+#include <buy_order_finder.hpp>
+#include <order_counter.hpp>
+#include <parse.hpp>
+#include <sell_order_finder.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Number of bestSellAtTime queries per symbol, spread evenly over the feed.
+    constexpr size_t SELL_QUERIES = 100;
+
+    constexpr Timestamp BAR_WIDTH = 60000000;
+
+    struct Options
+    {
+        FeedConfig feed;
+        unsigned repeats = 3;
+        std::string feedFile;
+    };
+
+    struct Result
+    {
+        std::string stage;
+        double bestMs;
+        double meanMs;
+    };
+
+    Options parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; i += 2)
+        {
+            if (i + 1 == argc)
+            {
+                throw std::runtime_error(std::string{"No value for option "} + argv[i]);
+            }
+
+            const std::string name = argv[i];
+            const std::string value = argv[i + 1];
+            if (name == "--seed")
+            {
+                options.feed.seed = std::stoull(value);
+            }
+            else if (name == "--records")
+            {
+                options.feed.records = std::stoull(value);
+            }
+            else if (name == "--symbols")
+            {
+                options.feed.symbols = std::stoull(value);
+            }
+            else if (name == "--lifetime")
+            {
+                options.feed.orderLifetime = std::stoull(value);
+            }
+            else if (name == "--amend")
+            {
+                options.feed.amendShare = std::stod(value);
+            }
+            else if (name == "--cancel")
+            {
+                options.feed.cancelShare = std::stod(value);
+            }
+            else if (name == "--repeats")
+            {
+                options.repeats = std::max(1ul, std::stoul(value));
+            }
+            else if (name == "--save")
+            {
+                options.feedFile = value;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option " + name);
+            }
+        }
+        return options;
+    }
+
+    // Runs the stage `repeats` times, prepare is not timed.
+    Result measure(const std::string& stage, unsigned repeats, const std::function<void()>& prepare, const std::function<void()>& run)
+    {
+        auto best = std::numeric_limits<double>::max();
+        double total = 0;
+        for (unsigned i = 0; i < repeats; ++i)
+        {
+            prepare();
+            const auto start = Clock::now();
+            run();
+            const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+            total += elapsed.count();
+        }
+        return {stage, best, total / repeats};
+    }
+
+    std::vector<Symbol> symbolsOf(const std::vector<Record>& records)
+    {
+        std::vector<Symbol> result;
+        for (const auto& record : records)
+        {
+            result.push_back(record.symbol);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // The worst case for the top set: buy orders of every symbol are inserted, then cancelled
+    // from the biggest one, so each cancel removes the best order. Has the same number of records.
+    std::vector<Record> biggestFirstCancels(const std::vector<Symbol>& symbols, size_t size)
+    {
+        std::vector<Record> result;
+        if (symbols.empty())
+        {
+            return result;
+        }
+
+        result.reserve(size);
+        const auto orders = size / 2;
+        for (size_t i = 0; i < orders; ++i)
+        {
+            result.push_back(Record{i, symbols[i % symbols.size()], static_cast<OrderID>(i), static_cast<Volume>(i + 1), 1000,
+                                    Operation::INSERT, Side::BUY});
+        }
+        for (auto i = orders; i-- > 0;)
+        {
+            result.push_back(Record{2 * orders - i, symbols[i % symbols.size()], static_cast<OrderID>(i), static_cast<Volume>(i + 1), 1000,
+                                    Operation::CANCEL, Side::BUY});
+        }
+        if (result.size() < size)
+        {
+            // an unknown order
+            result.push_back(Record{2 * orders, symbols.front(), static_cast<OrderID>(orders), 1, 1000, Operation::CANCEL, Side::BUY});
+        }
+        return result;
+    }
+
+    std::vector<Result> runBenchmarks(const Options& options, const std::string& feed, const std::vector<Record>& records)
+    {
+        const auto symbols = symbolsOf(records);
+        const auto firstTs = records.empty() ? 0 : records.front().ts;
+        const auto lastTs = records.empty() ? 0 : records.back().ts;
+        const auto noPreparation = []{};
+
+        // keeps results alive so the work is not optimized away
+        volatile size_t sink = 0;
+        std::vector<Result> results;
+
+        std::istringstream stream;
+        results.push_back(measure("parse", options.repeats,
+            [&]{ stream.clear(); stream.str(feed); },
+            [&]{ sink = sink + recordsFromStream(stream).size(); }));
+
+        results.push_back(measure("count", options.repeats, noPreparation, [&]
+        {
+            OrderCounter counter;
+            for (const auto& record : records)
+            {
+                counter.add(record);
+            }
+            sink = sink + counter.orderCounts().size();
+        }));
+
+        results.push_back(measure("top_k", options.repeats, noPreparation, [&]
+        {
+            BuyOrderFinder finder;
+            for (const auto& record : records)
+            {
+                finder.add(record);
+            }
+            for (const auto symbol : symbols)
+            {
+                sink = sink + finder.biggestBuyOrders(symbol).size();
+            }
+        }));
+
+        const auto cancels = biggestFirstCancels(symbols, records.size());
+        results.push_back(measure("top_k_cancel_best", options.repeats, noPreparation, [&]
+        {
+            BuyOrderFinder finder;
+            for (const auto& record : cancels)
+            {
+                finder.add(record);
+            }
+            for (const auto symbol : symbols)
+            {
+                sink = sink + finder.biggestBuyOrders(symbol).size();
+            }
+        }));
+
+        results.push_back(measure("best_sell", options.repeats, noPreparation, [&]
+        {
+            SellOrderFinder finder;
+            for (const auto& record : records)
+            {
+                finder.add(record);
+            }
+            for (const auto symbol : symbols)
+            {
+                for (size_t i = 0; i < SELL_QUERIES; ++i)
+                {
+                    const auto ts = firstTs + (lastTs - firstTs) * i / SELL_QUERIES;
+                    sink = sink + finder.bestSellAtTime(symbol, ts).has_value();
+                }
+            }
+        }));
+
+        results.push_back(measure("book", options.repeats, noPreparation, [&]
+        {
+            BookBuilder builder;
+            for (const auto& record : records)
+            {
+                builder.add(record);
+            }
+            for (const auto symbol : symbols)
+            {
+                sink = sink + builder.bestBid(symbol).has_value();
+            }
+        }));
+
+        results.push_back(measure("bars", options.repeats, noPreparation, [&]
+        {
+            BarAggregator aggregator{BAR_WIDTH};
+            for (const auto& record : records)
+            {
+                aggregator.add(record);
+            }
+            for (const auto symbol : symbols)
+            {
+                sink = sink + aggregator.bars(symbol).size();
+            }
+        }));
+
+        return results;
+    }
+
+    void printJson(const Options& options, size_t numberOfRecords, size_t feedBytes, const std::vector<Result>& results)
+    {
+        const auto& feed = options.feed;
+        std::cout << std::fixed << std::setprecision(3)
+                  << "{\n"
+                  << "  \"config\": {\n"
+                  << "    \"seed\": " << feed.seed << ",\n"
+                  << "    \"records\": " << feed.records << ",\n"
+                  << "    \"symbols\": " << feed.symbols << ",\n"
+                  << "    \"order_lifetime\": " << feed.orderLifetime << ",\n"
+                  << "    \"amend_share\": " << feed.amendShare << ",\n"
+                  << "    \"cancel_share\": " << feed.cancelShare << ",\n"
+                  << "    \"repeats\": " << options.repeats << ",\n"
+                  << "    \"feed_bytes\": " << feedBytes << "\n"
+                  << "  },\n"
+                  << "  \"results\": [\n";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& result = results[i];
+            const auto recordsPerSecond = result.bestMs > 0 ? numberOfRecords * 1000.0 / result.bestMs : 0.0;
+            std::cout << "    {\"stage\": \"" << result.stage << "\""
+                      << ", \"best_ms\": " << result.bestMs
+                      << ", \"mean_ms\": " << result.meanMs
+                      << ", \"records_per_second\": " << std::setprecision(0) << recordsPerSecond << std::setprecision(3)
+                      << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        std::cout << "  ]\n"
+                  << "}" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto options = parseOptions(argc, argv);
+
+        const auto records = generateFeed(options.feed);
+        const auto feed = feedToString(records);
+        if (!options.feedFile.empty())
+        {
+            std::ofstream output(options.feedFile, std::ios::binary);
+            if (!output.good())
+            {
+                throw std::runtime_error("Failed to open file '" + options.feedFile + "' for writing.");
+            }
+            output << feed;
+        }
+
+        printJson(options, records.size(), feed.size(), runBenchmarks(options, feed, records));
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " [--seed N] [--records N] [--symbols N] [--lifetime N]"
+                  << " [--amend SHARE] [--cancel SHARE] [--repeats N] [--save <path to data file>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
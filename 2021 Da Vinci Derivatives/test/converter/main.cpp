@@ -0,0 +1,54 @@
+#include <capture.hpp>
+#include <parse.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void convert(const std::string& input, const std::string& output)
+    {
+        std::ifstream stream(input);
+        if (!stream.good())
+        {
+            throw std::runtime_error("Failed to open file '" + input + "' for reading.");
+        }
+
+        CaptureWriter writer{output};
+        size_t numberOfRecords = 0;
+        for (std::string line; std::getline(stream, line); ++numberOfRecords)
+        {
+            writer.add(recordFromString(line));
+        }
+        writer.finish();
+
+        const CaptureReader reader{output};
+        std::cout << "Number of records: " << numberOfRecords << "\n"
+                  << "Number of blocks: " << reader.blocks().size() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc != 3)
+        {
+            throw std::runtime_error("Wrong number of arguments");
+        }
+
+        convert(argv[1], argv[2]);
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " <path to data file> <path to capture file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,145 @@
+#include <flat_hash_map.hpp>
+#include <parse.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    constexpr unsigned REPEATS = 5;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Position
+    {
+        Price price;
+        Volume volume;
+    };
+
+    std::vector<Record> readRecords(int argc, char* argv[])
+    {
+        if (argc != 2)
+        {
+            throw std::runtime_error("Wrong number of arguments");
+        }
+
+        return recordsFromFile(argv[1]);
+    }
+
+    // Replays the feed the way OrderCounter uses its per-symbol sets of active orders.
+    template <typename SymbolMap>
+    size_t replaySymbolOrders(const std::vector<Record>& records)
+    {
+        SymbolMap activeOrders;
+        for (const auto& record : records)
+        {
+            if (record.operation == Operation::INSERT)
+            {
+                activeOrders[record.symbol].insert(record.orderID);
+            }
+            else if (record.operation == Operation::CANCEL)
+            {
+                const auto it = activeOrders.find(record.symbol);
+                if (it != activeOrders.end())
+                {
+                    it->second.erase(record.orderID);
+                }
+            }
+        }
+        return activeOrders.size();
+    }
+
+    // Replays the feed the way the finders keep per-order state.
+    template <typename OrderMap>
+    size_t replayOrderState(const std::vector<Record>& records)
+    {
+        OrderMap activeOrders;
+        size_t found = 0;
+        for (const auto& record : records)
+        {
+            switch (record.operation)
+            {
+                case Operation::INSERT:
+                    activeOrders[record.orderID] = Position{record.price, record.volume};
+                    break;
+
+                case Operation::AMEND:
+                    {
+                        const auto it = activeOrders.find(record.orderID);
+                        if (it != activeOrders.end())
+                        {
+                            it->second = Position{record.price, record.volume};
+                            ++found;
+                        }
+                    }
+                    break;
+
+                case Operation::CANCEL:
+                    found += activeOrders.erase(record.orderID);
+                    break;
+            }
+        }
+        return found + activeOrders.size();
+    }
+
+    template <typename Function>
+    double bestTimeMs(Function function, const std::vector<Record>& records)
+    {
+        auto best = std::numeric_limits<double>::max();
+        for (unsigned i = 0; i < REPEATS; ++i)
+        {
+            const auto start = Clock::now();
+            const volatile auto result = function(records);
+            (void)result;
+            const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    void report(const std::string& name, double stdMs, double flatMs)
+    {
+        std::cout << std::left << std::setw(24) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << stdMs
+                  << std::setw(12) << flatMs
+                  << std::setw(10) << stdMs / flatMs << "x\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto records = readRecords(argc, argv);
+        std::cout << "Number of records: " << records.size() << ", best of " << REPEATS << " runs\n\n";
+
+        std::cout << std::left << std::setw(24) << "Benchmark"
+                  << std::right << std::setw(12) << "std, ms"
+                  << std::setw(12) << "flat, ms"
+                  << std::setw(11) << "speedup" << "\n";
+
+        report("symbol -> order IDs",
+               bestTimeMs(replaySymbolOrders<std::unordered_map<Symbol, std::unordered_set<OrderID>>>, records),
+               bestTimeMs(replaySymbolOrders<FlatHashMap<Symbol, FlatHashSet<OrderID>>>, records));
+
+        report("order ID -> position",
+               bestTimeMs(replayOrderState<std::unordered_map<OrderID, Position>>, records),
+               bestTimeMs(replayOrderState<FlatHashMap<OrderID, Position>>, records));
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " <path to data file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -1,22 +1,72 @@
 #include <buy_order_finder.hpp>
+#include <live_analytics.hpp>
+#include <merge_reader.hpp>
 #include <order_counter.hpp>
 #include <parse.hpp>
 #include <sell_order_finder.hpp>
 
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 namespace
 {
-    std::vector<Record> readRecords(int argc, char* argv[])
+    const std::string_view BUY_SYMBOL = "DVAM1";
+    const std::string_view SELL_SYMBOL = "DVAM1";
+    const std::string_view SELL_TIMESTAMP = "15:30:00";
+
+    const std::string_view FOLLOW_OPTION = "--follow";
+    constexpr std::chrono::seconds FOLLOW_REPORT_PERIOD{1};
+
+    bool followMode(int argc, char* argv[])
     {
-        if (argc != 2)
+        if (argc == 3 && argv[2] == FOLLOW_OPTION)
+        {
+            return true;
+        }
+        if (argc < 2)
         {
             throw std::runtime_error("Wrong number of arguments");
         }
+        return false;
+    }
 
-        return recordsFromFile(argv[1]);
+    void printOrderCounts(const std::unordered_map<Symbol, uint32_t>& orders)
+    {
+        std::cout << "Order counts output:\n";
+        for (const auto& [symbol, numberOfOrders] : orders)
+        {
+            std::cout << symbolToString(symbol) << " -> " << numberOfOrders << "\n";
+        }
+        std::cout << std::endl;
+    }
+
+    void printBiggestBuyOrders(const std::vector<BuyOrderFinder::BuyOrder>& orders)
+    {
+        std::cout << "Biggest buy orders output (\"" << BUY_SYMBOL << "\"):\n";
+        for (const auto& order : orders)
+        {
+            std::cout << timestampToString(order.ts) << ";"
+                      << symbolToString(order.symbol) << ";"
+                      << order.orderID << ";" << order.volume << ";" << order.price << "\n";
+        }
+        std::cout << std::endl;
+    }
+
+    void printBestSellAtTime(const std::optional<SellOrderFinder::SellPosition>& bestSell)
+    {
+        std::cout << "Best sell at Time (\"" << SELL_SYMBOL << "\", \"" << SELL_TIMESTAMP << "\"):\n";
+        if (!bestSell)
+        {
+            std::cout << "NONE\n";
+        }
+        else
+        {
+            std::cout << priceToDouble(bestSell->price) << ";" << bestSell->volume << "\n";
+        }
+        std::cout << std::endl;
     }
 
     void testOrderCounter(const std::vector<Record>& records)
@@ -27,14 +77,7 @@ namespace
             counter.add(record);
         }
 
-        const auto orders = counter.orderCounts();
-
-        std::cout << "Order counts output:\n";
-        for (const auto& [symbol, numberOfOrders] : orders)
-        {
-            std::cout << symbolToString(symbol) << " -> " << numberOfOrders << "\n";
-        }
-        std::cout << std::endl;
+        printOrderCounts(counter.orderCounts());
     }
 
     void testBuyOrderFinder(const std::vector<Record>& records)
@@ -45,17 +88,7 @@ namespace
             finder.add(record);
         }
 
-        const std::string_view symbol = "DVAM1";
-        const auto orders = finder.biggestBuyOrders(symbolFromString(symbol));
-
-        std::cout << "Biggest buy orders output (\"" << symbol << "\"):\n";
-        for (const auto& order : orders)
-        {
-            std::cout << timestampToString(order.ts) << ";"
-                      << symbolToString(order.symbol) << ";"
-                      << order.orderID << ";" << order.volume << ";" << order.price << "\n";
-        }
-        std::cout << std::endl;
+        printBiggestBuyOrders(finder.biggestBuyOrders(symbolFromString(BUY_SYMBOL)));
     }
 
     void testBestSellAtTimeFinder(const std::vector<Record>& records)
@@ -66,20 +99,51 @@ namespace
             finder.add(record);
         }
 
-        const std::string_view symbol = "DVAM1";
-        const std::string_view ts = "15:30:00";
-        const auto bestSell = finder.bestSellAtTime(symbolFromString(symbol), timestampFromString(ts));
+        printBestSellAtTime(finder.bestSellAtTime(symbolFromString(SELL_SYMBOL), timestampFromString(SELL_TIMESTAMP)));
+    }
 
-        std::cout << "Best sell at Time (\"" << symbol << "\", \"" << ts << "\"):\n";
-        if (!bestSell)
-        {
-            std::cout << "NONE\n";
-        }
-        else
+    // Several files are merged into one stream by timestamp.
+    void testFiles(const std::vector<std::string>& filenames)
+    {
+        const auto records = filenames.size() == 1 ? recordsFromFile(filenames.front()) : recordsFromFiles(filenames);
+        std::cout << "Number of records: " << records.size() << "\n\n";
+
+        testOrderCounter(records);
+        testBuyOrderFinder(records);
+        testBestSellAtTimeFinder(records);
+    }
+
+    // Prints the same output as testFiles every time new records are appended to the file.
+    void followFile(const std::string& filename)
+    {
+        LiveAnalytics analytics{filename};
+        analytics.start();
+
+        uint64_t reportedRecords = 0;
+        uint64_t reportedMalformedLines = 0;
+        while (analytics.isRunning())
         {
-            std::cout << priceToDouble(bestSell->price) << ";" << bestSell->volume << "\n";
+            const auto numberOfMalformedLines = analytics.numberOfMalformedLines();
+            if (numberOfMalformedLines != reportedMalformedLines)
+            {
+                reportedMalformedLines = numberOfMalformedLines;
+                std::cerr << "Malformed lines skipped: " << numberOfMalformedLines << "\n\n";
+            }
+
+            const auto numberOfRecords = analytics.numberOfRecords();
+            if (numberOfRecords != reportedRecords)
+            {
+                reportedRecords = numberOfRecords;
+                std::cout << "Number of records: " << numberOfRecords << "\n\n";
+
+                printOrderCounts(analytics.orderCounts());
+                printBiggestBuyOrders(analytics.biggestBuyOrders(symbolFromString(BUY_SYMBOL)));
+                printBestSellAtTime(analytics.bestSellAtTime(symbolFromString(SELL_SYMBOL), timestampFromString(SELL_TIMESTAMP)));
+            }
+            std::this_thread::sleep_for(FOLLOW_REPORT_PERIOD);
         }
-        std::cout << std::endl;
+
+        analytics.stop();
     }
 }
 
@@ -87,12 +151,14 @@ int main(int argc, char* argv[])
 {
     try
     {
-        const auto records = readRecords(argc, argv);
-        std::cout << "Number of records: " << records.size() << "\n\n";
-
-        testOrderCounter(records);
-        testBuyOrderFinder(records);
-        testBestSellAtTimeFinder(records);
+        if (followMode(argc, argv))
+        {
+            followFile(argv[1]);
+        }
+        else
+        {
+            testFiles({argv + 1, argv + argc});
+        }
 
         return EXIT_SUCCESS;
     }
@@ -100,7 +166,8 @@ int main(int argc, char* argv[])
     {
         std::cerr << "ERROR: " << e.what() << "\n"
                   << "Usage:\n"
-                  << "\t" << argv[0] << " <path to data file>" << std::endl;
+                  << "\t" << argv[0] << " <path to data file> [<path to data file> ...]\n"
+                  << "\t" << argv[0] << " <path to data file> " << FOLLOW_OPTION << std::endl;
         return EXIT_FAILURE;
     }
-}
\ No newline at end of file
+}
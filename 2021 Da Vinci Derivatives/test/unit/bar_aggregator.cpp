@@ -0,0 +1,222 @@
+#include <bar_aggregator.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    const Timestamp MINUTE = timestampFromString("00:01:00.000000");
+}
+
+TEST_CASE("BarAggregator :: Zero width", "[bar-aggregator]")
+{
+    CHECK_THROWS(BarAggregator{0});
+}
+
+TEST_CASE("BarAggregator :: Unknown symbol", "[bar-aggregator]")
+{
+    const BarAggregator aggregator{MINUTE};
+    CHECK(aggregator.bars(symbolFromString("A")).size() == 0);
+    CHECK(aggregator.symbols().empty());
+}
+
+TEST_CASE("BarAggregator :: Order flow", "[bar-aggregator]")
+{
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:00:00.000000;A;1;I;BUY;10;12.0"));
+    aggregator.add(recordFromString("10:00:10.000000;A;2;I;SELL;30;13.0"));
+    aggregator.add(recordFromString("10:00:20.000000;A;1;A;BUY;20;12.0"));
+    aggregator.add(recordFromString("10:00:59.999999;A;2;C;SELL;30;13.0"));
+    aggregator.add(recordFromString("10:02:00.000000;A;3;I;SELL;5;14.0"));
+    aggregator.add(recordFromString("10:00:30.000000;B;4;I;BUY;1;1.0"));
+
+    const auto& bars = aggregator.bars(symbolFromString("A"));
+    REQUIRE(bars.size() == 2);
+
+    CHECK(bars.start[0] == timestampFromString("10:00:00.000000"));
+    CHECK(bars.buyVolume[0] == 30);
+    CHECK(bars.sellVolume[0] == 30);
+    CHECK(bars.cancelVolume[0] == 30);
+    CHECK(bars.vwap(0) == Approx(125.0));
+
+    CHECK(bars.start[1] == timestampFromString("10:02:00.000000"));
+    CHECK(bars.buyVolume[1] == 0);
+    CHECK(bars.sellVolume[1] == 5);
+    CHECK(bars.vwap(1) == Approx(140.0));
+
+    REQUIRE(bars.profileOffset.size() == 3);
+    CHECK(bars.profileOffset[1] == 2);
+    CHECK(bars.profilePrice[0] == 120);
+    CHECK(bars.profileVolume[0] == 30);
+    CHECK(bars.profilePrice[1] == 130);
+    CHECK(bars.profileVolume[1] == 30);
+    CHECK(bars.profilePrice[2] == 140);
+    CHECK(bars.profileVolume[2] == 5);
+
+    CHECK(aggregator.symbols() == std::vector<Symbol>{symbolFromString("A"), symbolFromString("B")});
+}
+
+TEST_CASE("BarAggregator :: Best price OHLC", "[bar-aggregator]")
+{
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:00:00.000000;A;1;I;SELL;10;13.0"));
+    aggregator.add(recordFromString("10:00:01.000000;A;2;I;SELL;10;12.5"));
+    aggregator.add(recordFromString("10:00:02.000000;A;3;I;SELL;10;12.8"));
+    aggregator.add(recordFromString("10:00:03.000000;A;2;C;SELL;10;12.5"));
+    aggregator.add(recordFromString("10:01:00.000000;A;1;C;SELL;10;13.0"));
+    aggregator.add(recordFromString("10:01:01.000000;A;3;C;SELL;10;12.8"));
+
+    const auto& bars = aggregator.bars(symbolFromString("A"));
+    REQUIRE(bars.size() == 2);
+
+    CHECK(bars.askOpen[0] == 130);
+    CHECK(bars.askHigh[0] == 130);
+    CHECK(bars.askLow[0] == 125);
+    CHECK(bars.askClose[0] == 128);
+    CHECK(bars.bidOpen[0] == BarColumns::NO_PRICE);
+    CHECK(bars.bidHigh[0] == BarColumns::NO_PRICE);
+
+    CHECK(bars.askOpen[1] == 128);
+    CHECK(bars.askHigh[1] == 128);
+    CHECK(bars.askLow[1] == 128);
+    CHECK(bars.askClose[1] == BarColumns::NO_PRICE);
+}
+
+TEST_CASE("BarAggregator :: Unsorted records", "[bar-aggregator]")
+{
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:01:00.000000;A;1;I;SELL;10;13.0"));
+    CHECK_THROWS(aggregator.add(recordFromString("10:00:00.000000;A;2;I;SELL;10;12.0")));
+
+    // the rejected order is not in the book
+    aggregator.add(recordFromString("10:01:01.000000;A;3;I;BUY;5;12.5"));
+    const auto& bars = aggregator.bars(symbolFromString("A"));
+    REQUIRE(bars.size() == 1);
+    CHECK(bars.sellVolume[0] == 10);
+    CHECK(bars.askLow[0] == 130);
+    CHECK(bars.askClose[0] == 130);
+}
+
+TEST_CASE("BarAggregator :: CSV", "[bar-aggregator]")
+{
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:00:00.000000;A;1;I;BUY;10;12.5"));
+    aggregator.add(recordFromString("10:00:01.000000;A;2;I;BUY;30;12.0"));
+
+    std::ostringstream stream;
+    aggregator.writeCsv(stream);
+
+    std::istringstream lines{stream.str()};
+    std::string header;
+    std::string line;
+    REQUIRE(std::getline(lines, header));
+    REQUIRE(std::getline(lines, line));
+    CHECK(line == "A,10:00:00.000000,40,0,0,12.125,12.5,12.5,12.5,12.5,,,,,12.5:10 12:30");
+    CHECK_FALSE(std::getline(lines, line));
+}
+
+TEST_CASE("BarAggregator :: Binary file", "[bar-aggregator]")
+{
+    const auto filename = (std::filesystem::temp_directory_path() / "bar_aggregator_bars.bin").string();
+
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:00:00.000000;A;1;I;BUY;10;12.5"));
+    aggregator.add(recordFromString("10:00:00.000000;B;2;I;SELL;10;13.5"));
+    aggregator.add(recordFromString("10:05:00.000000;A;3;I;SELL;30;12.7"));
+    aggregator.writeBinary(filename);
+
+    const auto file = barsFromFile(filename);
+    CHECK(file.width == MINUTE);
+    REQUIRE(file.symbols.size() == 2);
+
+    const auto& [symbol, bars] = file.symbols[0];
+    const auto& expected = aggregator.bars(symbolFromString("A"));
+    CHECK(symbol == symbolFromString("A"));
+    CHECK(bars.start == expected.start);
+    CHECK(bars.buyVolume == expected.buyVolume);
+    CHECK(bars.sellVolume == expected.sellVolume);
+    CHECK(bars.notional == expected.notional);
+    CHECK(bars.bidClose == expected.bidClose);
+    CHECK(bars.askLow == expected.askLow);
+    CHECK(bars.profileOffset == expected.profileOffset);
+    CHECK(bars.profilePrice == expected.profilePrice);
+    CHECK(bars.profileVolume == expected.profileVolume);
+
+    std::remove(filename.c_str());
+    CHECK_THROWS_WITH(barsFromFile(filename), Catch::Matchers::Contains("Failed to open file"));
+}
+
+TEST_CASE("BarAggregator :: Corrupted binary file", "[bar-aggregator]")
+{
+    const auto filename = (std::filesystem::temp_directory_path() / "bar_aggregator_corrupted.bin").string();
+
+    BarAggregator aggregator{MINUTE};
+    aggregator.add(recordFromString("10:00:00.000000;A;1;I;BUY;10;12.5"));
+    aggregator.add(recordFromString("10:05:00.000000;A;3;I;SELL;30;12.7"));
+    aggregator.writeBinary(filename);
+
+    std::string data;
+    {
+        std::ifstream input(filename, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+    }
+
+    const auto write = [&](const std::string& content)
+    {
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        output << content;
+    };
+
+    // magic, version, width, number of symbols, symbol, then the length of the first column
+    constexpr size_t FIRST_COLUMN_LENGTH = 8 + 4 + 8 + 8 + 8;
+
+    SECTION("truncated")
+    {
+        write(data.substr(0, data.size() - 1));
+        CHECK_THROWS_WITH(barsFromFile(filename), Catch::Matchers::Contains("Malformed bars data"));
+    }
+
+    SECTION("huge column length")
+    {
+        auto corrupted = data;
+        const uint64_t length = uint64_t{1} << 60;
+        std::memcpy(&corrupted[FIRST_COLUMN_LENGTH], &length, sizeof(length));
+        write(corrupted);
+        CHECK_THROWS_WITH(barsFromFile(filename), Catch::Matchers::Contains("Malformed bars data"));
+    }
+
+    SECTION("columns of different sizes")
+    {
+        // the first column claims one bar less, the rest of the file is read shifted
+        auto corrupted = data;
+        uint64_t length = 0;
+        std::memcpy(&length, &corrupted[FIRST_COLUMN_LENGTH], sizeof(length));
+        --length;
+        std::memcpy(&corrupted[FIRST_COLUMN_LENGTH], &length, sizeof(length));
+        write(corrupted);
+        CHECK_THROWS_WITH(barsFromFile(filename), Catch::Matchers::Contains("Malformed bars data"));
+    }
+
+    SECTION("profile offsets out of range")
+    {
+        const auto& bars = aggregator.bars(symbolFromString("A"));
+        const auto offsetsEnd = data.size() - (8 + bars.profilePrice.size() * sizeof(Price)) - (8 + bars.profileVolume.size() * sizeof(uint64_t));
+
+        auto corrupted = data;
+        const uint32_t offset = 1000;
+        std::memcpy(&corrupted[offsetsEnd - sizeof(offset)], &offset, sizeof(offset));
+        write(corrupted);
+        CHECK_THROWS_WITH(barsFromFile(filename), Catch::Matchers::Contains("Malformed bars data"));
+    }
+
+    std::remove(filename.c_str());
+}
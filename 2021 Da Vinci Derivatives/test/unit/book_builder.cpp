@@ -0,0 +1,253 @@
+#include <book_builder.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <map>
+#include <random>
+
+TEST_CASE("BookBuilder :: Empty book", "[book-builder]")
+{
+    const BookBuilder builder;
+    const auto symbol = symbolFromString("A");
+
+    CHECK_FALSE(builder.bestBid(symbol));
+    CHECK_FALSE(builder.bestAsk(symbol));
+    CHECK(builder.l2(symbol).bids.empty());
+    CHECK(builder.l3(symbol).asks.empty());
+    CHECK(builder.numberOfOrders(symbol) == 0);
+}
+
+TEST_CASE("BookBuilder :: Both sides", "[book-builder]")
+{
+    BookBuilder builder;
+    builder.add(recordFromString("10:00:00.000000;A;1;I;BUY;5;12.5"));
+    builder.add(recordFromString("10:00:01.000000;A;2;I;SELL;37;13.5"));
+    builder.add(recordFromString("10:00:02.000000;A;3;I;BUY;10;12.7"));
+    builder.add(recordFromString("10:00:03.000000;A;4;I;SELL;7;13.3"));
+    builder.add(recordFromString("10:00:04.000000;A;5;I;BUY;55;12.7"));
+    builder.add(recordFromString("10:00:05.000000;B;6;I;BUY;1;100"));
+
+    const auto symbol = symbolFromString("A");
+    CHECK(builder.numberOfOrders(symbol) == 5);
+
+    const auto bestBid = builder.bestBid(symbol);
+    REQUIRE(bestBid);
+    CHECK(bestBid->price == 127);
+    CHECK(bestBid->volume == 65);
+    CHECK(bestBid->orders == 2);
+
+    const auto bestAsk = builder.bestAsk(symbol);
+    REQUIRE(bestAsk);
+    CHECK(bestAsk->price == 133);
+    CHECK(bestAsk->volume == 7);
+
+    const auto l2 = builder.l2(symbol);
+    REQUIRE(l2.bids.size() == 2);
+    CHECK(l2.bids[1].price == 125);
+    CHECK(l2.bids[1].volume == 5);
+    REQUIRE(l2.asks.size() == 2);
+    CHECK(l2.asks[1].price == 135);
+    CHECK(l2.asks[1].volume == 37);
+
+    const auto l3 = builder.l3(symbol, 1);
+    REQUIRE(l3.bids.size() == 1);
+    REQUIRE(l3.bids[0].orders.size() == 2);
+    CHECK(l3.bids[0].orders[0].orderID == 3);
+    CHECK(l3.bids[0].orders[1].orderID == 5);
+    REQUIRE(l3.asks.size() == 1);
+    CHECK(l3.asks[0].orders[0].orderID == 4);
+}
+
+TEST_CASE("BookBuilder :: Cancel", "[book-builder]")
+{
+    BookBuilder builder;
+    builder.add(recordFromString("10:00:00.000000;A;1;I;SELL;5;12.5"));
+    builder.add(recordFromString("10:00:01.000000;A;2;I;SELL;6;12.6"));
+    builder.add(recordFromString("10:00:02.000000;A;3;I;SELL;7;14.0"));
+    builder.add(recordFromString("10:00:03.000000;A;1;C;SELL;5;12.5"));
+    builder.add(recordFromString("10:00:04.000000;A;2;C;SELL;6;12.6"));
+    builder.add(recordFromString("10:00:05.000000;A;9;C;SELL;6;12.6"));
+
+    const auto symbol = symbolFromString("A");
+    const auto bestAsk = builder.bestAsk(symbol);
+    REQUIRE(bestAsk);
+    CHECK(bestAsk->price == 140);
+    CHECK(bestAsk->volume == 7);
+
+    builder.add(recordFromString("10:00:06.000000;A;3;C;SELL;7;14.0"));
+    CHECK_FALSE(builder.bestAsk(symbol));
+    CHECK(builder.numberOfOrders(symbol) == 0);
+}
+
+TEST_CASE("BookBuilder :: Amend loses priority", "[book-builder]")
+{
+    BookBuilder builder;
+    builder.add(recordFromString("10:00:00.000000;A;1;I;BUY;5;12.5"));
+    builder.add(recordFromString("10:00:01.000000;A;2;I;BUY;6;12.5"));
+    builder.add(recordFromString("10:00:02.000000;A;1;A;BUY;4;12.5"));
+
+    const auto l3 = builder.l3(symbolFromString("A"));
+    REQUIRE(l3.bids.size() == 1);
+    CHECK(l3.bids[0].volume == 10);
+    REQUIRE(l3.bids[0].orders.size() == 2);
+    CHECK(l3.bids[0].orders[0].orderID == 2);
+    CHECK(l3.bids[0].orders[1].orderID == 1);
+    CHECK(l3.bids[0].orders[1].volume == 4);
+}
+
+TEST_CASE("BookBuilder :: Amend moves price level", "[book-builder]")
+{
+    BookBuilder builder;
+    builder.add(recordFromString("10:00:00.000000;A;1;I;BUY;5;12.5"));
+    builder.add(recordFromString("10:00:01.000000;A;1;A;BUY;5;1000.0"));
+    builder.add(recordFromString("10:00:02.000000;A;2;I;BUY;3;0.1"));
+
+    const auto l2 = builder.l2(symbolFromString("A"));
+    REQUIRE(l2.bids.size() == 2);
+    CHECK(l2.bids[0].price == 10000);
+    CHECK(l2.bids[1].price == 1);
+}
+
+TEST_CASE("BookBuilder :: Outlier prices", "[book-builder]")
+{
+    BookBuilder builder;
+    builder.add(recordFromString("10:00:00.000000;A;1;I;BUY;5;100000.0"));
+    builder.add(recordFromString("10:00:01.000000;A;2;I;BUY;6;0.1"));
+    builder.add(recordFromString("10:00:02.000000;A;3;I;BUY;7;99999.9"));
+    builder.add(recordFromString("10:00:03.000000;A;4;I;SELL;8;100000.1"));
+    builder.add(Record{Timestamp{}, symbolFromString("A"), 5, 9, std::numeric_limits<Price>::max(), Operation::INSERT, Side::SELL});
+    builder.add(Record{Timestamp{}, symbolFromString("A"), 6, 10, std::numeric_limits<Price>::min(), Operation::INSERT, Side::BUY});
+
+    const auto symbol = symbolFromString("A");
+    auto l2 = builder.l2(symbol);
+    REQUIRE(l2.bids.size() == 4);
+    CHECK(l2.bids[0].price == 1000000);
+    CHECK(l2.bids[1].price == 999999);
+    CHECK(l2.bids[2].price == 1);
+    CHECK(l2.bids[3].price == std::numeric_limits<Price>::min());
+    REQUIRE(l2.asks.size() == 2);
+    CHECK(l2.asks[0].price == 1000001);
+    CHECK(l2.asks[1].price == std::numeric_limits<Price>::max());
+
+    // the best levels move to the outliers and back
+    builder.add(recordFromString("10:00:04.000000;A;1;C;BUY;5;100000.0"));
+    builder.add(recordFromString("10:00:05.000000;A;3;C;BUY;7;99999.9"));
+    builder.add(recordFromString("10:00:06.000000;A;4;C;SELL;8;100000.1"));
+    CHECK(builder.bestBid(symbol)->price == 1);
+    CHECK(builder.bestAsk(symbol)->price == std::numeric_limits<Price>::max());
+
+    builder.add(recordFromString("10:00:07.000000;A;7;I;BUY;11;0.2"));
+    builder.add(recordFromString("10:00:08.000000;A;8;I;SELL;12;0.3"));
+    CHECK(builder.bestBid(symbol)->price == 2);
+    CHECK(builder.bestAsk(symbol)->price == 3);
+
+    l2 = builder.l2(symbol);
+    REQUIRE(l2.bids.size() == 3);
+    CHECK(l2.bids[0].price == 2);
+    CHECK(l2.bids[1].price == 1);
+    CHECK(l2.bids[2].price == std::numeric_limits<Price>::min());
+    CHECK(l2.bids[2].volume == 10);
+    REQUIRE(l2.asks.size() == 2);
+    CHECK(l2.asks[1].volume == 9);
+
+    builder.add(recordFromString("10:00:09.000000;A;7;C;BUY;11;0.2"));
+    builder.add(recordFromString("10:00:10.000000;A;2;C;BUY;6;0.1"));
+    CHECK(builder.bestBid(symbol)->price == std::numeric_limits<Price>::min());
+    CHECK(builder.numberOfOrders(symbol) == 3);
+}
+
+TEST_CASE("BookBuilder :: Stale best order", "[book-builder]")
+{
+    // the market moves far below a best bid which is never cancelled
+    BookBuilder builder;
+    const auto symbol = symbolFromString("A");
+    builder.add(Record{0, symbol, 0, 1, 100000, Operation::INSERT, Side::BUY});
+    for (OrderID i = 1; i <= 1000; ++i)
+    {
+        builder.add(Record{i, symbol, i, i, static_cast<Price>(1000 + i), Operation::INSERT, Side::BUY});
+    }
+    for (OrderID i = 1; i <= 1000; i += 2)
+    {
+        builder.add(Record{i, symbol, i, i, static_cast<Price>(1000 + i), Operation::CANCEL, Side::BUY});
+    }
+    CHECK(builder.bestBid(symbol)->price == 100000);
+
+    builder.add(Record{2000, symbol, 0, 1, 100000, Operation::CANCEL, Side::BUY});
+    CHECK(builder.bestBid(symbol)->price == 2000);
+    CHECK(builder.bestBid(symbol)->volume == 1000);
+
+    const auto l2 = builder.l2(symbol);
+    REQUIRE(l2.bids.size() == 500);
+    for (size_t i = 0; i < l2.bids.size(); ++i)
+    {
+        CHECK(l2.bids[i].price == static_cast<Price>(2000 - 2 * i));
+    }
+    CHECK(builder.numberOfOrders(symbol) == 500);
+}
+
+TEST_CASE("BookBuilder :: Same as naive book", "[book-builder]")
+{
+    // the wide range does not fit into the window of the ladder
+    const auto priceRange = GENERATE(100u, 5000u);
+
+    BookBuilder builder;
+    std::map<OrderID, Record> orders;
+    std::mt19937 generator{7};
+    const auto symbol = symbolFromString("A");
+
+    for (OrderID i = 0; i < 20000; ++i)
+    {
+        Record record{i, symbol, static_cast<OrderID>(generator() % 300), static_cast<Volume>(generator() % 100 + 1), static_cast<Price>(1000 + generator() % priceRange),
+                      static_cast<Operation>(generator() % 3), static_cast<Side>(generator() % 2)};
+        builder.add(record);
+        if (record.operation == Operation::CANCEL)
+        {
+            orders.erase(record.orderID);
+        }
+        else
+        {
+            orders[record.orderID] = record;
+        }
+    }
+
+    std::map<Price, Volume, std::greater<Price>> bids;
+    std::map<Price, Volume> asks;
+    for (const auto& [orderID, record] : orders)
+    {
+        if (record.side == Side::BUY)
+        {
+            bids[record.price] += record.volume;
+        }
+        else
+        {
+            asks[record.price] += record.volume;
+        }
+    }
+
+    CHECK(builder.numberOfOrders(symbol) == orders.size());
+    CHECK(builder.bestBid(symbol)->price == bids.begin()->first);
+    CHECK(builder.bestAsk(symbol)->price == asks.begin()->first);
+
+    const auto l2 = builder.l2(symbol);
+    REQUIRE(l2.bids.size() == bids.size());
+    REQUIRE(l2.asks.size() == asks.size());
+
+    size_t i = 0;
+    for (const auto& [price, volume] : bids)
+    {
+        CHECK(l2.bids[i].price == price);
+        CHECK(l2.bids[i].volume == volume);
+        ++i;
+    }
+
+    i = 0;
+    for (const auto& [price, volume] : asks)
+    {
+        CHECK(l2.asks[i].price == price);
+        CHECK(l2.asks[i].volume == volume);
+        ++i;
+    }
+}
@@ -0,0 +1,237 @@
+#include <capture.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    std::string tempFileName(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<Record> makeRecords(size_t count)
+    {
+        std::vector<Record> result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(Record{
+                timestampFromString("10:00:00.000000") + i * 1000,
+                symbolFromString(i % 3 == 0 ? "DVAM1" : "DVAM2"),
+                static_cast<OrderID>(i / 2 + 1),
+                static_cast<Volume>(i % 100 + 1),
+                static_cast<Price>(i % 2 == 0 ? 125 - static_cast<Price>(i % 7) : -3),
+                static_cast<Operation>(i % 3),
+                static_cast<Side>(i % 2)
+            });
+        }
+        return result;
+    }
+
+    void checkEqual(const Record& a, const Record& b)
+    {
+        CHECK(a.ts == b.ts);
+        CHECK(a.symbol == b.symbol);
+        CHECK(a.orderID == b.orderID);
+        CHECK(a.volume == b.volume);
+        CHECK(a.price == b.price);
+        CHECK(a.operation == b.operation);
+        CHECK(a.side == b.side);
+    }
+}
+
+TEST_CASE("Capture :: Empty", "[capture]")
+{
+    const auto filename = tempFileName("capture_empty.dvc");
+    recordsToCapture({}, filename);
+
+    CaptureReader reader{filename};
+    CHECK(reader.blocks().empty());
+    CHECK(reader.read().empty());
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Capture :: Round trip", "[capture]")
+{
+    const auto filename = tempFileName("capture_round_trip.dvc");
+    const auto records = makeRecords(10000);
+    recordsToCapture(records, filename);
+
+    CaptureReader reader{filename};
+    CHECK(reader.blocks().size() == 3);
+    CHECK(reader.size() == records.size());
+
+    const auto result = reader.read();
+    REQUIRE(result.size() == records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        checkEqual(result[i], records[i]);
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Capture :: Time range", "[capture]")
+{
+    const auto filename = tempFileName("capture_time_range.dvc");
+    const auto records = makeRecords(100);
+    {
+        CaptureWriter writer{filename, 16};
+        for (const auto& record : records)
+        {
+            writer.add(record);
+        }
+    }
+
+    CaptureReader reader{filename};
+    REQUIRE(reader.blocks().size() == 7);
+    CHECK(reader.blocks()[1].minTs == records[16].ts);
+    CHECK(reader.blocks()[1].maxTs == records[31].ts);
+
+    const auto result = reader.read(records[20].ts, records[40].ts);
+    REQUIRE(result.size() == 21);
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        checkEqual(result[i], records[20 + i]);
+    }
+
+    CHECK(recordsFromCapture(filename, records[99].ts + 1, records[99].ts + 100).empty());
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Capture :: Not a capture", "[capture]")
+{
+    const auto filename = tempFileName("capture_not_a_capture.dvc");
+    {
+        std::ofstream output(filename);
+        output << "10:00:00.000000;A;1;I;BUY;1;1\n10:00:00.000000;A;1;I;BUY;1;1\n";
+    }
+
+    CHECK_THROWS_WITH(CaptureReader{filename}, Catch::Matchers::Contains("Not a capture file"));
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Capture :: Corrupted file", "[capture]")
+{
+    const auto filename = tempFileName("capture_corrupted.dvc");
+    recordsToCapture(makeRecords(10), filename);
+
+    std::string data;
+    {
+        std::ifstream input(filename, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{});
+    }
+
+    const auto write = [&](const std::string& content)
+    {
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        output << content;
+    };
+
+    // the only block follows the file header, the index is followed by its offset, the number of blocks and magic
+    constexpr size_t BLOCK_OFFSET = 16;
+    constexpr size_t PAYLOAD_OFFSET = BLOCK_OFFSET + 8;
+    uint64_t indexOffset = 0;
+    std::memcpy(&indexOffset, &data[data.size() - 24], sizeof(indexOffset));
+
+    SECTION("huge number of blocks")
+    {
+        auto corrupted = data;
+        const uint64_t blocks = uint64_t{1} << 60;
+        std::memcpy(&corrupted[data.size() - 16], &blocks, sizeof(blocks));
+        write(corrupted);
+        CHECK_THROWS_WITH(CaptureReader{filename}, Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    SECTION("huge number of records")
+    {
+        auto corrupted = data;
+        const uint32_t records = uint32_t{1} << 30;
+        std::memcpy(&corrupted[indexOffset + 8], &records, sizeof(records));
+        std::memcpy(&corrupted[BLOCK_OFFSET], &records, sizeof(records));
+        write(corrupted);
+        CHECK_THROWS_WITH(CaptureReader{filename}, Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    SECTION("huge payload")
+    {
+        auto corrupted = data;
+        const uint32_t payloadSize = 0xFFFFFFFF;
+        std::memcpy(&corrupted[BLOCK_OFFSET + 4], &payloadSize, sizeof(payloadSize));
+        write(corrupted);
+        CaptureReader reader{filename};
+        CHECK_THROWS_WITH(reader.read(), Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    SECTION("huge number of symbols")
+    {
+        auto corrupted = data;
+        corrupted[PAYLOAD_OFFSET] = 0x7F;
+        write(corrupted);
+        CaptureReader reader{filename};
+        CHECK_THROWS_WITH(reader.read(), Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    SECTION("unknown operation")
+    {
+        // the flags of the last record end the block
+        auto corrupted = data;
+        corrupted[indexOffset - 1] = 3;
+        write(corrupted);
+        CaptureReader reader{filename};
+        CHECK_THROWS_WITH(reader.read(), Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    SECTION("unknown side")
+    {
+        auto corrupted = data;
+        corrupted[indexOffset - 1] = 2 << 2;
+        write(corrupted);
+        CaptureReader reader{filename};
+        CHECK_THROWS_WITH(reader.read(), Catch::Matchers::Contains("Malformed capture data"));
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Capture :: No file", "[capture]")
+{
+    CHECK_THROWS_WITH(CaptureReader{tempFileName("capture_no_such_file.dvc")}, Catch::Matchers::Contains("Failed to open file"));
+}
+
+TEST_CASE("Capture :: Filter", "[capture]")
+{
+    const auto filename = tempFileName("capture_filter.dvc");
+    const auto records = makeRecords(100);
+    {
+        CaptureWriter writer{filename, 16};
+        for (const auto& record : records)
+        {
+            writer.add(record);
+        }
+    }
+
+    RecordFilter filter;
+    filter.symbols = {symbolFromString("DVAM1")};
+    filter.from = records[10].ts;
+    filter.to = records[30].ts;
+    const auto result = recordsFromCapture(filename, filter);
+
+    REQUIRE(result.size() == 7);
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        checkEqual(result[i], records[12 + 3 * i]);
+    }
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,121 @@
+#include <feed_follower.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string tempFileName(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    void append(const std::string& filename, const std::string& data)
+    {
+        std::ofstream output(filename, std::ios::app | std::ios::binary);
+        output << data;
+    }
+}
+
+TEST_CASE("FeedFollower :: No file", "[feed-follower]")
+{
+    CHECK_THROWS_WITH(FeedFollower{tempFileName("feed_follower_no_such_file.txt")}, Catch::Matchers::Contains("Failed to open file"));
+}
+
+TEST_CASE("FeedFollower :: Appended lines", "[feed-follower]")
+{
+    const auto filename = tempFileName("feed_follower_appended_lines.txt");
+    std::ofstream{filename, std::ios::trunc};
+
+    FeedFollower follower{filename};
+    std::vector<Record> records;
+    const auto callback = [&](const Record& record){ records.push_back(record); };
+
+    CHECK(follower.poll(callback) == 0);
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\n10:00:01.000000;A;2;I;SELL;6;15.60\n");
+    CHECK(follower.poll(callback) == 2);
+
+    append(filename, "10:00:02.000000;A;3;I;B");
+    CHECK(follower.poll(callback) == 0);
+
+    append(filename, "UY;7;15.70\n10:00:03");
+    CHECK(follower.poll(callback) == 1);
+
+    REQUIRE(records.size() == 3);
+    CHECK(records[0].orderID == 1);
+    CHECK(records[1].orderID == 2);
+    CHECK(records[2].orderID == 3);
+    CHECK(records[2].side == Side::BUY);
+    CHECK(records[2].volume == 7);
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("FeedFollower :: Rewritten file", "[feed-follower]")
+{
+    const auto filename = tempFileName("feed_follower_rewritten_file.txt");
+    std::ofstream{filename, std::ios::trunc} << "10:00:00.000000;A;1;I;BUY;5;15.50\n10:00:01.000000;A;2;I;SELL;6;15.60\n";
+
+    FeedFollower follower{filename};
+    std::vector<Record> records;
+    const auto callback = [&](const Record& record){ records.push_back(record); };
+
+    CHECK(follower.poll(callback) == 2);
+
+    std::ofstream{filename, std::ios::trunc} << "10:00:02.000000;A;3;I;BUY;7;15.70\n";
+    CHECK(follower.poll(callback) == 1);
+
+    REQUIRE(records.size() == 3);
+    CHECK(records[2].orderID == 3);
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("FeedFollower :: Wait", "[feed-follower]")
+{
+    const auto filename = tempFileName("feed_follower_wait.txt");
+    std::ofstream{filename, std::ios::trunc};
+
+    FeedFollower follower{filename};
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\n");
+    CHECK(follower.wait(std::chrono::milliseconds{1000}));
+    CHECK(follower.poll([](const Record&){}) == 1);
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("FeedFollower :: Malformed line", "[feed-follower]")
+{
+    const auto filename = tempFileName("feed_follower_malformed_line.txt");
+    std::ofstream{filename, std::ios::trunc};
+
+    FeedFollower follower{filename};
+    std::vector<Record> records;
+    const auto callback = [&](const Record& record){ records.push_back(record); };
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\nmalformed\n10:00:01.000000;A;2;I;SELL;6;15.60\n10:00:02");
+    CHECK_THROWS_AS(follower.poll(callback), MalformedLineError);
+    REQUIRE(records.size() == 1);
+    CHECK(records[0].orderID == 1);
+
+    // the malformed line is skipped, the lines after it are not lost
+    append(filename, ".000000;A;3;I;BUY;7;15.70\n");
+    CHECK(follower.poll(callback) == 2);
+    REQUIRE(records.size() == 3);
+    CHECK(records[1].orderID == 2);
+    CHECK(records[2].orderID == 3);
+
+    CHECK(follower.poll(callback) == 0);
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,120 @@
+#include <flat_hash_map.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <unordered_map>
+
+TEST_CASE("FlatHashMap :: Empty", "[flat-hash-map]")
+{
+    FlatHashMap<OrderID, int> map;
+
+    CHECK(map.empty());
+    CHECK(map.size() == 0);
+    CHECK(map.find(1) == map.end());
+    CHECK(map.begin() == map.end());
+    CHECK(map.erase(1) == 0);
+}
+
+TEST_CASE("FlatHashMap :: Insert and find", "[flat-hash-map]")
+{
+    FlatHashMap<Symbol, int> map;
+    map[1] = 10;
+    const auto [it, inserted] = map.try_emplace(2, 20);
+    CHECK(inserted);
+    CHECK(it->second == 20);
+
+    const auto [existingIt, existingInserted] = map.try_emplace(1, 30);
+    CHECK_FALSE(existingInserted);
+    CHECK(existingIt->second == 10);
+
+    REQUIRE(map.size() == 2);
+    CHECK(map.find(1)->second == 10);
+    CHECK(map.find(2)->second == 20);
+    CHECK(map.contains(2));
+    CHECK_FALSE(map.contains(3));
+}
+
+TEST_CASE("FlatHashMap :: Erase", "[flat-hash-map]")
+{
+    FlatHashMap<OrderID, int> map;
+    for (OrderID id = 0; id < 100; ++id)
+    {
+        map[id] = static_cast<int>(id);
+    }
+
+    for (OrderID id = 0; id < 100; id += 2)
+    {
+        CHECK(map.erase(id) == 1);
+    }
+    map.erase(map.find(1));
+
+    REQUIRE(map.size() == 49);
+    CHECK_FALSE(map.contains(1));
+    for (OrderID id = 3; id < 100; id += 2)
+    {
+        REQUIRE(map.contains(id));
+        CHECK(map.find(id)->second == static_cast<int>(id));
+    }
+}
+
+TEST_CASE("FlatHashMap :: Iteration", "[flat-hash-map]")
+{
+    FlatHashMap<OrderID, int> map;
+    for (OrderID id = 1; id <= 10; ++id)
+    {
+        map[id] = static_cast<int>(id);
+    }
+
+    int sum = 0;
+    for (const auto& [id, value] : map)
+    {
+        CHECK(value == static_cast<int>(id));
+        sum += value;
+    }
+    CHECK(sum == 55);
+}
+
+TEST_CASE("FlatHashMap :: Same as std::unordered_map", "[flat-hash-map]")
+{
+    FlatHashMap<OrderID, int> map;
+    std::unordered_map<OrderID, int> expected;
+    std::mt19937 generator{42};
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        const OrderID id = generator() % 1000;
+        if (generator() % 2 == 0)
+        {
+            map[id] = i;
+            expected[id] = i;
+        }
+        else
+        {
+            REQUIRE(map.erase(id) == expected.erase(id));
+        }
+        REQUIRE(map.size() == expected.size());
+    }
+
+    for (const auto& [id, value] : expected)
+    {
+        REQUIRE(map.contains(id));
+        CHECK(map.find(id)->second == value);
+    }
+}
+
+TEST_CASE("FlatHashSet :: Insert and erase", "[flat-hash-map]")
+{
+    FlatHashSet<OrderID> set;
+
+    CHECK(set.insert(1).second);
+    CHECK(set.insert(2).second);
+    CHECK_FALSE(set.insert(1).second);
+    CHECK(set.size() == 2);
+
+    CHECK(set.erase(1) == 1);
+    CHECK(set.erase(1) == 0);
+    CHECK(set.size() == 1);
+    CHECK(*set.begin() == 2);
+}
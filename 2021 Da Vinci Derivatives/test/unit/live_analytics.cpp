@@ -0,0 +1,106 @@
+#include <live_analytics.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    std::string tempFileName(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    void append(const std::string& filename, const std::string& data)
+    {
+        std::ofstream output(filename, std::ios::app | std::ios::binary);
+        output << data;
+    }
+}
+
+TEST_CASE("LiveAnalytics :: Update", "[live-analytics]")
+{
+    const auto filename = tempFileName("live_analytics_update.txt");
+    std::ofstream{filename, std::ios::trunc};
+    const auto symbol = symbolFromString("A");
+
+    LiveAnalytics analytics{filename};
+    CHECK(analytics.update() == 0);
+    CHECK(analytics.orderCounts().empty());
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\n10:00:01.000000;A;2;I;SELL;6;15.60\n");
+    CHECK(analytics.update() == 2);
+    CHECK(analytics.numberOfRecords() == 2);
+    CHECK(analytics.orderCounts().at(symbol) == 2);
+    CHECK(analytics.biggestBuyOrders(symbol).size() == 1);
+
+    append(filename, "10:00:02.000000;A;2;C;SELL;6;15.60\n");
+    CHECK(analytics.update() == 1);
+    CHECK(analytics.orderCounts().at(symbol) == 1);
+    CHECK(analytics.bestSellAtTime(symbol, timestampFromString("10:00:01.500000")));
+    CHECK_FALSE(analytics.bestSellAtTime(symbol, timestampFromString("10:00:02.500000")));
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("LiveAnalytics :: Malformed line", "[live-analytics]")
+{
+    const auto filename = tempFileName("live_analytics_malformed_line.txt");
+    std::ofstream{filename, std::ios::trunc};
+    const auto symbol = symbolFromString("A");
+
+    LiveAnalytics analytics{filename};
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\nmalformed\n10:00:01.000000;A;2;I;SELL;6;15.60\n");
+    CHECK_THROWS_AS(analytics.update(), MalformedLineError);
+    CHECK(analytics.numberOfRecords() == 1);
+    CHECK(analytics.orderCounts().at(symbol) == 1);
+
+    CHECK(analytics.update() == 1);
+    CHECK(analytics.numberOfRecords() == 2);
+    CHECK(analytics.orderCounts().at(symbol) == 2);
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("LiveAnalytics :: Background thread", "[live-analytics]")
+{
+    const auto filename = tempFileName("live_analytics_background_thread.txt");
+    std::ofstream{filename, std::ios::trunc};
+
+    LiveAnalytics analytics{filename};
+    analytics.start();
+
+    append(filename, "10:00:00.000000;A;1;I;BUY;5;15.50\n");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (analytics.numberOfRecords() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    CHECK(analytics.numberOfRecords() == 1);
+    CHECK(analytics.isRunning());
+
+    // a malformed line is skipped, the following lines are applied
+    append(filename, "malformed\n10:00:01.000000;A;2;I;BUY;6;15.60\n");
+    append(filename, "10:00:02.000000;A;3;I;SELL;7;15.70\n");
+    while (analytics.numberOfRecords() < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        CHECK_NOTHROW(analytics.orderCounts());
+    }
+    CHECK(analytics.numberOfRecords() == 3);
+    CHECK(analytics.numberOfMalformedLines() == 1);
+    CHECK(analytics.orderCounts().at(symbolFromString("A")) == 3);
+    CHECK(analytics.isRunning());
+    CHECK_NOTHROW(analytics.stop());
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,106 @@
+#include <merge_reader.hpp>
+#include <parse.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string writeFile(const std::string& name, const std::string& data)
+    {
+        const auto filename = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream output(filename, std::ios::trunc | std::ios::binary);
+        output << data;
+        return filename;
+    }
+
+    std::vector<OrderID> orderIDs(const std::vector<Record>& records)
+    {
+        std::vector<OrderID> result;
+        for (const auto& record : records)
+        {
+            result.push_back(record.orderID);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("MergeReader :: No file", "[merge-reader]")
+{
+    const auto filename = (std::filesystem::temp_directory_path() / "merge_reader_no_such_file.txt").string();
+    CHECK_THROWS_WITH(MergeReader{std::vector<std::string>{filename}}, Catch::Matchers::Contains("Failed to open file"));
+}
+
+TEST_CASE("MergeReader :: No files", "[merge-reader]")
+{
+    MergeReader reader{std::vector<std::string>{}};
+    CHECK_FALSE(reader.next());
+}
+
+TEST_CASE("MergeReader :: Merge by timestamp", "[merge-reader]")
+{
+    const auto first = writeFile("merge_reader_first.txt",
+        "10:00:00.000000;A;1;I;BUY;5;15.5\n"
+        "10:00:02.000000;A;3;I;BUY;5;15.5\n"
+        "10:00:02.000000;A;4;I;BUY;5;15.5\n"
+        "10:00:05.000000;A;7;I;BUY;5;15.5\n");
+    const auto second = writeFile("merge_reader_second.txt",
+        "10:00:01.000000;B;2;I;SELL;6;15.6\n"
+        "10:00:02.000000;B;5;I;SELL;6;15.6\n"
+        "10:00:03.000000;B;6;I;SELL;6;15.6\n");
+    const auto empty = writeFile("merge_reader_empty.txt", "");
+
+    for (const size_t readAhead : {1, 2, 1024})
+    {
+        MergeReader reader{std::vector<std::string>{first, empty, second}, readAhead};
+
+        std::vector<Record> records;
+        while (const auto record = reader.next())
+        {
+            records.push_back(*record);
+        }
+
+        CHECK(orderIDs(records) == std::vector<OrderID>{1, 2, 3, 4, 5, 6, 7});
+        CHECK(records[1].symbol == symbolFromString("B"));
+        CHECK_FALSE(reader.next());
+    }
+
+    CHECK(orderIDs(recordsFromFiles(std::vector<std::string>{second, first})) == std::vector<OrderID>{1, 2, 5, 3, 4, 6, 7});
+
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+    std::remove(empty.c_str());
+}
+
+TEST_CASE("MergeReader :: Multiple days", "[merge-reader]")
+{
+    const auto monday = writeFile("merge_reader_monday.txt",
+        "09:00:00.000000;A;1;I;BUY;5;15.5\n"
+        "17:00:00.000000;A;2;I;BUY;5;15.5\n");
+    const auto tuesday = writeFile("merge_reader_tuesday.txt",
+        "08:00:00.000000;A;3;I;BUY;5;15.5\n");
+
+    const auto records = recordsFromFiles(std::vector<MergeSource>{{tuesday, US_PER_DAY}, {monday, 0}});
+    REQUIRE(orderIDs(records) == std::vector<OrderID>{1, 2, 3});
+    CHECK(records[2].ts == US_PER_DAY + timestampFromString("08:00:00.000000"));
+
+    std::remove(monday.c_str());
+    std::remove(tuesday.c_str());
+}
+
+TEST_CASE("MergeReader :: Unsorted file", "[merge-reader]")
+{
+    const auto filename = writeFile("merge_reader_unsorted.txt",
+        "10:00:01.000000;A;1;I;BUY;5;15.5\n"
+        "10:00:00.000000;A;2;I;BUY;5;15.5\n");
+
+    CHECK_THROWS_WITH(recordsFromFiles(std::vector<std::string>{filename}), Catch::Matchers::Contains("is not sorted"));
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,128 @@
+#include <price_history.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    std::vector<PriceHistory::Entry> randomEntries(size_t size)
+    {
+        std::vector<PriceHistory::Entry> result;
+        std::mt19937 generator{3};
+        Timestamp ts = 1000;
+        Price price = 1000;
+        for (size_t i = 0; i < size; ++i)
+        {
+            ts += generator() % 3 == 0 ? 0 : generator() % 2000;
+            if (generator() % 50 == 0)
+            {
+                result.push_back({ts, std::numeric_limits<Price>::min(), 0});
+                continue;
+            }
+            price = std::max(10, price + static_cast<Price>(generator() % 9) - 4);
+            result.push_back({ts, price, static_cast<Volume>(generator() % 1000 + 1)});
+        }
+        return result;
+    }
+
+    // The last entry with entry.ts <= ts, or nullptr.
+    const PriceHistory::Entry* naiveAt(const std::vector<PriceHistory::Entry>& entries, Timestamp ts)
+    {
+        const PriceHistory::Entry* result = nullptr;
+        for (const auto& entry : entries)
+        {
+            if (entry.ts <= ts)
+            {
+                result = &entry;
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("PriceHistory :: Empty", "[price-history]")
+{
+    const PriceHistory history;
+
+    CHECK(history.empty());
+    CHECK(history.size() == 0);
+    CHECK_FALSE(history.at(100));
+
+    PriceHistory::Cursor cursor{history};
+    CHECK(cursor.advance(100) == nullptr);
+}
+
+TEST_CASE("PriceHistory :: Back", "[price-history]")
+{
+    PriceHistory history;
+    history.add({10, 125, 5});
+    history.add({12, std::numeric_limits<Price>::min(), 0});
+
+    CHECK(history.size() == 2);
+    CHECK(history.back().ts == 12);
+    CHECK(history.back().price == std::numeric_limits<Price>::min());
+}
+
+TEST_CASE("PriceHistory :: Same as uncompressed", "[price-history]")
+{
+    const auto entries = randomEntries(PriceHistory::BLOCK_SIZE * 20 + 7);
+
+    PriceHistory history;
+    for (const auto& entry : entries)
+    {
+        history.add(entry);
+    }
+    REQUIRE(history.size() == entries.size());
+
+    PriceHistory::Cursor cursor{history};
+    for (Timestamp ts = 0; ts <= entries.back().ts + 10; ts += 97)
+    {
+        const auto expected = naiveAt(entries, ts);
+        const auto found = history.at(ts);
+        const auto swept = cursor.advance(ts);
+
+        REQUIRE(found.has_value() == (expected != nullptr));
+        REQUIRE((swept != nullptr) == (expected != nullptr));
+        if (expected)
+        {
+            CHECK(found->ts == expected->ts);
+            CHECK(found->price == expected->price);
+            CHECK(found->volume == expected->volume);
+            CHECK(swept->ts == expected->ts);
+            CHECK(swept->price == expected->price);
+            CHECK(swept->volume == expected->volume);
+        }
+    }
+}
+
+TEST_CASE("PriceHistory :: Equal timestamps over block boundary", "[price-history]")
+{
+    PriceHistory history;
+    for (size_t i = 0; i < PriceHistory::BLOCK_SIZE * 3; ++i)
+    {
+        history.add({100, static_cast<Price>(i), static_cast<Volume>(i)});
+    }
+
+    const auto entry = history.at(100);
+    REQUIRE(entry);
+    CHECK(entry->volume == PriceHistory::BLOCK_SIZE * 3 - 1);
+    CHECK_FALSE(history.at(99));
+}
+
+TEST_CASE("PriceHistory :: Compression", "[price-history]")
+{
+    const auto entries = randomEntries(90000);
+
+    PriceHistory history;
+    for (const auto& entry : entries)
+    {
+        history.add(entry);
+    }
+
+    CHECK(history.memoryUsage() * 2 < entries.size() * sizeof(PriceHistory::Entry));
+}
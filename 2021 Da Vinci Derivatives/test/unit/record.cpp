@@ -94,3 +94,89 @@ TEST_CASE("RecordsFromStream :: Simple stream", "[parse-record]")
     CHECK(records[1].volume == 7);
     CHECK(records[1].price == 57);
 }
+
+TEST_CASE("RecordsFromStream :: Filter by timestamp", "[parse-record]")
+{
+    std::stringstream stream;
+    stream << "10:00:00.000000;A;1;I;BUY;5;15.50\n"
+           << "11:00:00.000000;B;2;I;SELL;6;15.60\n"
+           << "12:00:00.000000;A;3;C;BUY;7;15.70\n"
+           << "13:00:00.000000;A;4;I;BUY;8;15.80\n";
+
+    RecordFilter filter;
+    filter.from = timestampFromString("11:00:00.000000");
+    filter.to = timestampFromString("12:00:00.000000");
+    const auto records = recordsFromStream(stream, filter);
+
+    REQUIRE(records.size() == 2);
+    CHECK(records[0].orderID == 2);
+    CHECK(records[1].orderID == 3);
+}
+
+TEST_CASE("RecordsFromStream :: Filter by symbol", "[parse-record]")
+{
+    std::stringstream stream;
+    stream << "10:00:00.000000;A;1;I;BUY;5;15.50\n"
+           << "11:00:00.000000;B;2;I;SELL;6;15.60\n"
+           << "12:00:00.000000;DVAM1;3;C;BUY;7;15.70\n"
+           << "13:00:00.000000;C;4;I;BUY;8;15.80\n";
+
+    RecordFilter filter;
+    filter.symbols = {symbolFromString("A"), symbolFromString("DVAM1")};
+    const auto records = recordsFromStream(stream, filter);
+
+    REQUIRE(records.size() == 2);
+    CHECK(records[0].orderID == 1);
+    CHECK(records[1].orderID == 3);
+}
+
+TEST_CASE("RecordsFromStream :: Filter keeps malformed records", "[parse-record]")
+{
+    std::stringstream stream;
+    stream << "10:00:00.000000;A;1;I;BUY;5;15.50\n"
+           << "13:00:00.000000;LONGSYMBOL;4;I;BUY;8;15.80\n";
+
+    RecordFilter filter;
+    filter.symbols = {symbolFromString("A")};
+
+    CHECK_THROWS_WITH(recordsFromStream(stream, filter), Catch::Matchers::Contains("is to long"));
+}
+
+TEST_CASE("RecordsFromStream :: Skipped records are not parsed", "[parse-record]")
+{
+    std::stringstream stream;
+    stream << "10:00:00.000000;A;1;I;BUY;5;15.50\n"
+           << "11:00:00.000000;B;2;X;SELL;6;15.60\n"
+           << "12:00:00.000000;A;3;C;BUY;7;15.70\n";
+
+    RecordFilter filter;
+    filter.symbols = {symbolFromString("A")};
+    const auto records = recordsFromStream(stream, filter);
+
+    REQUIRE(records.size() == 2);
+}
+
+TEST_CASE("RecordsFromStream :: Sorted records", "[parse-record]")
+{
+    std::stringstream stream;
+    stream << "10:00:00.000000;A;1;I;BUY;5;15.50\n"
+           << "11:00:00.000000;A;2;I;SELL;6;15.60\n"
+           << "12:00:00.000000;A;3;C;BUY;7;15.70\n"
+           << "10:30:00.000000;A;4;I;BUY;8;15.80\n";
+
+    RecordFilter filter;
+    filter.to = timestampFromString("11:00:00.000000");
+
+    SECTION("Unsorted")
+    {
+        const auto records = recordsFromStream(stream, filter);
+        CHECK(records.size() == 3);
+    }
+
+    SECTION("Sorted")
+    {
+        filter.sortedByTime = true;
+        const auto records = recordsFromStream(stream, filter);
+        CHECK(records.size() == 2);
+    }
+}
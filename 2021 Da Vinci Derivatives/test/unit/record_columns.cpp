@@ -0,0 +1,183 @@
+#include <buy_order_finder.hpp>
+#include <order_counter.hpp>
+#include <parse.hpp>
+#include <record_columns.hpp>
+#include <sell_order_finder.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+namespace
+{
+    const std::vector<Record> RECORDS = {
+        recordFromString("10:00:00.000000;A;1;I;BUY;5;1.5"),
+        recordFromString("10:00:01.000000;B;2;I;SELL;7;2.5"),
+        recordFromString("10:00:02.000000;A;3;I;SELL;4;1.7"),
+        recordFromString("10:00:03.000000;A;1;A;BUY;6;1.5"),
+        recordFromString("09:00:00.000000;B;2;C;SELL;7;2.5"),
+        recordFromString("23:00:00.000000;A;4;I;BUY;3;1.4")
+    };
+
+    void checkEqual(const Record& a, const Record& b)
+    {
+        CHECK(a.ts == b.ts);
+        CHECK(a.symbol == b.symbol);
+        CHECK(a.orderID == b.orderID);
+        CHECK(a.volume == b.volume);
+        CHECK(a.price == b.price);
+        CHECK(a.operation == b.operation);
+        CHECK(a.side == b.side);
+    }
+}
+
+TEST_CASE("RecordColumns :: Round trip", "[record-columns]")
+{
+    auto encoding = GENERATE(RecordColumns::Encoding{false, false},
+                             RecordColumns::Encoding{true, false},
+                             RecordColumns::Encoding{false, true},
+                             RecordColumns::Encoding{true, true});
+
+    const RecordColumns columns{RECORDS, encoding};
+    REQUIRE(columns.size() == RECORDS.size());
+
+    for (size_t i = 0; i < RECORDS.size(); ++i)
+    {
+        checkEqual(columns.record(i), RECORDS[i]);
+    }
+
+    size_t row = 0;
+    columns.forEach([&](const Record& record){ checkEqual(record, RECORDS[row++]); });
+    CHECK(row == RECORDS.size());
+}
+
+TEST_CASE("RecordColumns :: Symbol dictionary", "[record-columns]")
+{
+    const RecordColumns plain{RECORDS};
+    CHECK(plain.symbolDictionary().empty());
+
+    const RecordColumns encoded{RECORDS, {true, false}};
+    REQUIRE(encoded.symbolDictionary().size() == 2);
+    CHECK(encoded.symbolDictionary()[0] == symbolFromString("A"));
+    CHECK(encoded.symbolDictionary()[1] == symbolFromString("B"));
+}
+
+TEST_CASE("RecordColumns :: Many timestamps", "[record-columns]")
+{
+    RecordColumns columns{{false, true}};
+    for (Timestamp ts = 0; ts < 5000; ++ts)
+    {
+        columns.push_back(Record{ts * 1000003, 1, 1, 1, 1, Operation::INSERT, Side::BUY});
+    }
+
+    for (Timestamp ts = 0; ts < 5000; ++ts)
+    {
+        REQUIRE(columns.timestamp(ts) == ts * 1000003);
+    }
+}
+
+TEST_CASE("RecordColumns :: Rows with side", "[record-columns]")
+{
+    const RecordColumns columns{RECORDS};
+
+    CHECK(columns.rowsWithSide(Side::BUY) == std::vector<uint32_t>{0, 3, 5});
+    CHECK(columns.rowsWithSide(Side::SELL) == std::vector<uint32_t>{1, 2, 4});
+
+    std::vector<OrderID> orders;
+    columns.forEach(Side::SELL, [&](const Record& record){ orders.push_back(record.orderID); });
+    CHECK(orders == std::vector<OrderID>{2, 3, 2});
+}
+
+TEST_CASE("RecordColumns :: Finders", "[record-columns]")
+{
+    const RecordColumns columns{RECORDS, {true, true}};
+    const auto symbol = symbolFromString("A");
+
+    OrderCounter counter;
+    counter.add(columns);
+    const auto counts = counter.orderCounts();
+    REQUIRE(counts.size() == 1);
+    CHECK(counts.at(symbol) == 3);
+
+    BuyOrderFinder buyFinder;
+    buyFinder.add(columns);
+    const auto buyOrders = buyFinder.biggestBuyOrders(symbol);
+    REQUIRE(buyOrders.size() == 2);
+    CHECK(buyOrders[0].orderID == 1);
+    CHECK(buyOrders[0].volume == 6);
+    CHECK(buyOrders[1].orderID == 4);
+
+    SellOrderFinder sellFinder;
+    sellFinder.add(columns);
+    const auto bestSell = sellFinder.bestSellAtTime(symbol, timestampFromString("12:00:00"));
+    REQUIRE(bestSell);
+    CHECK(bestSell->price == 17);
+    CHECK(bestSell->volume == 4);
+}
+
+TEST_CASE("RecordColumns :: Same as records", "[record-columns]")
+{
+    auto encoding = GENERATE(RecordColumns::Encoding{false, false},
+                             RecordColumns::Encoding{true, true});
+
+    std::mt19937 generator{11};
+    const std::vector<Symbol> symbols{symbolFromString("A"), symbolFromString("B"), symbolFromString("C")};
+
+    std::vector<Record> records;
+    std::vector<Timestamp> sortedTs;
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        const Timestamp ts = 1000 * i;
+        records.push_back(Record{ts, symbols[generator() % symbols.size()], static_cast<OrderID>(generator() % 200),
+                                 static_cast<Volume>(generator() % 100 + 1), static_cast<Price>(1000 + generator() % 50),
+                                 static_cast<Operation>(generator() % 3), static_cast<Side>(generator() % 2)});
+        sortedTs.push_back(ts);
+    }
+    const RecordColumns columns{records, encoding};
+
+    OrderCounter counter;
+    OrderCounter columnCounter;
+    BuyOrderFinder buyFinder;
+    BuyOrderFinder columnBuyFinder;
+    SellOrderFinder sellFinder;
+    SellOrderFinder columnSellFinder;
+    for (const auto& record : records)
+    {
+        counter.add(record);
+        buyFinder.add(record);
+        sellFinder.add(record);
+    }
+    columnCounter.add(columns);
+    columnBuyFinder.add(columns);
+    columnSellFinder.add(columns);
+
+    CHECK(columnCounter.orderCounts() == counter.orderCounts());
+
+    for (const auto symbol : symbols)
+    {
+        const auto buyOrders = buyFinder.biggestBuyOrders(symbol);
+        const auto columnBuyOrders = columnBuyFinder.biggestBuyOrders(symbol);
+        REQUIRE(columnBuyOrders.size() == buyOrders.size());
+        for (size_t i = 0; i < buyOrders.size(); ++i)
+        {
+            CHECK(columnBuyOrders[i].orderID == buyOrders[i].orderID);
+            CHECK(columnBuyOrders[i].ts == buyOrders[i].ts);
+            CHECK(columnBuyOrders[i].volume == buyOrders[i].volume);
+            CHECK(columnBuyOrders[i].price == buyOrders[i].price);
+        }
+
+        const auto sells = sellFinder.bestSellAtTimes(symbol, sortedTs);
+        const auto columnSells = columnSellFinder.bestSellAtTimes(symbol, sortedTs);
+        REQUIRE(columnSells.size() == sells.size());
+        for (size_t i = 0; i < sells.size(); ++i)
+        {
+            REQUIRE(columnSells[i].has_value() == sells[i].has_value());
+            if (sells[i])
+            {
+                CHECK(columnSells[i]->price == sells[i]->price);
+                CHECK(columnSells[i]->volume == sells[i]->volume);
+            }
+        }
+    }
+}
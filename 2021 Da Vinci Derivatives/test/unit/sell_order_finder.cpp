@@ -4,6 +4,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <random>
+#include <vector>
+
 TEST_CASE("BestSellAtTime :: No orders", "[best-sell-at-time]")
 {
     const auto record = recordFromString("10:00:00.000000;A;1;I;BUY;1;1");
@@ -203,3 +206,72 @@ TEST_CASE("BestSellAtTime :: Many orders", "[best-sell-at-time]")
     CHECK(bestSellC->price == record6.price);
     CHECK(bestSellC->volume == record6.volume);
 }
+
+TEST_CASE("BestSellAtTimes :: Unsorted timestamps", "[best-sell-at-time]")
+{
+    SellOrderFinder finder;
+    CHECK_THROWS(finder.bestSellAtTimes(symbolFromString("A"), {2, 1}));
+    CHECK_THROWS(finder.bestSellAtTimes({2, 1}));
+}
+
+TEST_CASE("BestSellAtTimes :: Unknown symbol", "[best-sell-at-time]")
+{
+    SellOrderFinder finder;
+    finder.add(recordFromString("10:00:00.000000;A;1;I;SELL;5;1"));
+
+    const auto bestSells = finder.bestSellAtTimes(symbolFromString("B"), {1, 2, 3});
+    REQUIRE(bestSells.size() == 3);
+    CHECK_FALSE(bestSells[0]);
+    CHECK_FALSE(bestSells[2]);
+}
+
+TEST_CASE("BestSellAtTimes :: Same as single queries", "[best-sell-at-time]")
+{
+    const std::vector<Symbol> symbols = {symbolFromString("A"), symbolFromString("B"), symbolFromString("C")};
+
+    SellOrderFinder finder;
+    std::mt19937 generator{11};
+    for (OrderID i = 0; i < 5000; ++i)
+    {
+        Record record{i * 10, symbols[generator() % symbols.size()], static_cast<OrderID>(generator() % 100),
+                      static_cast<Volume>(generator() % 100 + 1), static_cast<Price>(1000 + generator() % 100),
+                      static_cast<Operation>(generator() % 3), Side::SELL};
+        finder.add(record);
+    }
+
+    std::vector<Timestamp> timestamps;
+    for (Timestamp ts = 0; ts < 51000; ts += 7)
+    {
+        timestamps.push_back(ts);
+    }
+
+    const auto check = [&](const Symbol& symbol, const std::vector<std::optional<SellOrderFinder::SellPosition>>& bestSells)
+    {
+        REQUIRE(bestSells.size() == timestamps.size());
+        for (size_t i = 0; i < timestamps.size(); ++i)
+        {
+            const auto expected = finder.bestSellAtTime(symbol, timestamps[i]);
+            REQUIRE(bestSells[i].has_value() == expected.has_value());
+            if (expected)
+            {
+                CHECK(bestSells[i]->price == expected->price);
+                CHECK(bestSells[i]->volume == expected->volume);
+            }
+        }
+    };
+
+    for (const auto symbol : symbols)
+    {
+        check(symbol, finder.bestSellAtTimes(symbol, timestamps));
+    }
+
+    for (const size_t threads : {1, 2, 8})
+    {
+        const auto allBestSells = finder.bestSellAtTimes(timestamps, threads);
+        REQUIRE(allBestSells.size() == symbols.size());
+        for (const auto symbol : symbols)
+        {
+            check(symbol, allBestSells.at(symbol));
+        }
+    }
+}
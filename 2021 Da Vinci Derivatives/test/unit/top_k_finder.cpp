@@ -0,0 +1,246 @@
+#include <parse.hpp>
+#include <top_k_finder.hpp>
+#include <types.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+TEST_CASE("TopKFinder :: Zero K", "[top-k-finder]")
+{
+    const auto record = recordFromString("10:00:00.000000;A;1;I;BUY;1;1");
+
+    TopKFinder<Side::BUY> finder{0};
+    finder.add(record);
+    const auto orders = finder.top(record.symbol);
+
+    CHECK(orders.size() == 0);
+}
+
+TEST_CASE("TopKFinder :: Custom K", "[top-k-finder]")
+{
+    TopKFinder<Side::BUY> finder{5};
+    for (int i = 1; i <= 10; ++i)
+    {
+        finder.add(recordFromString("10:00:00.000000;A;" + std::to_string(i) + ";I;BUY;" + std::to_string(i) + ";1"));
+    }
+    const auto orders = finder.top(symbolFromString("A"));
+
+    REQUIRE(orders.size() == 5);
+    CHECK(orders[0].orderID == 10);
+    CHECK(orders[1].orderID == 9);
+    CHECK(orders[2].orderID == 8);
+    CHECK(orders[3].orderID == 7);
+    CHECK(orders[4].orderID == 6);
+}
+
+TEST_CASE("TopKFinder :: Sell side", "[top-k-finder]")
+{
+    const auto record1 = recordFromString("10:00:00.000000;A;1;I;BUY;5;1");
+    const auto record2 = recordFromString("10:00:01.000000;A;2;I;SELL;3;1");
+
+    TopKFinder<Side::SELL> finder{3};
+    finder.add(record1);
+    finder.add(record2);
+    const auto orders = finder.top(record1.symbol);
+
+    REQUIRE(orders.size() == 1);
+    CHECK(orders[0].orderID == record2.orderID);
+}
+
+TEST_CASE("TopKFinder :: Price key", "[top-k-finder]")
+{
+    const auto record1 = recordFromString("10:00:00.000000;A;1;I;BUY;5;1.5");
+    const auto record2 = recordFromString("10:00:01.000000;A;2;I;BUY;3;2.5");
+    const auto record3 = recordFromString("10:00:02.000000;A;3;I;BUY;4;0.5");
+
+    TopKFinder<Side::BUY, PriceKey> finder{2};
+    finder.add(record1);
+    finder.add(record2);
+    finder.add(record3);
+    const auto orders = finder.top(record1.symbol);
+
+    REQUIRE(orders.size() == 2);
+    CHECK(orders[0].orderID == record2.orderID);
+    CHECK(orders[1].orderID == record1.orderID);
+}
+
+TEST_CASE("TopKFinder :: Notional key", "[top-k-finder]")
+{
+    const auto record1 = recordFromString("10:00:00.000000;A;1;I;BUY;5;1");
+    const auto record2 = recordFromString("10:00:01.000000;A;2;I;BUY;3;2");
+    const auto record3 = recordFromString("10:00:02.000000;A;3;I;BUY;1;4");
+
+    TopKFinder<Side::BUY, NotionalKey> finder{3};
+    finder.add(record1);
+    finder.add(record2);
+    finder.add(record3);
+    const auto orders = finder.top(record1.symbol);
+
+    REQUIRE(orders.size() == 3);
+    CHECK(orders[0].orderID == record2.orderID);
+    CHECK(orders[1].orderID == record1.orderID);
+    CHECK(orders[2].orderID == record3.orderID);
+}
+
+TEST_CASE("TopKFinder :: Same key keeps insertion order", "[top-k-finder]")
+{
+    const auto record1 = recordFromString("10:00:00.000000;A;1;I;BUY;1;1");
+    const auto record2 = recordFromString("10:00:01.000000;A;2;I;BUY;1;1");
+    const auto record3 = recordFromString("10:00:02.000000;A;1;A;BUY;1;1");
+
+    TopKFinder<Side::BUY> finder{2};
+    finder.add(record1);
+    finder.add(record2);
+
+    auto orders = finder.top(record1.symbol);
+    REQUIRE(orders.size() == 2);
+    CHECK(orders[0].orderID == record1.orderID);
+    CHECK(orders[1].orderID == record2.orderID);
+
+    finder.add(record3);
+
+    orders = finder.top(record1.symbol);
+    REQUIRE(orders.size() == 2);
+    CHECK(orders[0].orderID == record2.orderID);
+    CHECK(orders[1].orderID == record1.orderID);
+}
+
+TEST_CASE("TopKFinder :: Cancels drain top set", "[top-k-finder]")
+{
+    TopKFinder<Side::BUY> finder{2};
+    for (int i = 1; i <= 20; ++i)
+    {
+        finder.add(recordFromString("10:00:00.000000;A;" + std::to_string(i) + ";I;BUY;" + std::to_string(i) + ";1"));
+    }
+    for (int i = 20; i > 5; --i)
+    {
+        finder.add(recordFromString("10:00:01.000000;A;" + std::to_string(i) + ";C;BUY;" + std::to_string(i) + ";1"));
+    }
+    const auto orders = finder.top(symbolFromString("A"));
+
+    REQUIRE(orders.size() == 2);
+    CHECK(orders[0].orderID == 5);
+    CHECK(orders[1].orderID == 4);
+}
+
+TEST_CASE("TopKFinder :: Cancels of candidates", "[top-k-finder]")
+{
+    // most of the orders out of the top set are cancelled, then the top set is drained
+    TopKFinder<Side::BUY> finder{2};
+    for (int i = 1; i <= 100; ++i)
+    {
+        finder.add(recordFromString("10:00:00.000000;A;" + std::to_string(i) + ";I;BUY;" + std::to_string(i) + ";1"));
+    }
+    for (int i = 1; i <= 90; ++i)
+    {
+        if (i % 10 != 0)
+        {
+            finder.add(recordFromString("10:00:01.000000;A;" + std::to_string(i) + ";C;BUY;" + std::to_string(i) + ";1"));
+        }
+    }
+
+    // the orders left, best first
+    std::vector<int> active;
+    for (int i = 100; i > 0; --i)
+    {
+        if (i > 90 || i % 10 == 0)
+        {
+            active.push_back(i);
+        }
+    }
+
+    while (active.size() > 1)
+    {
+        const auto orders = finder.top(symbolFromString("A"));
+        REQUIRE(orders.size() == 2);
+        CHECK(orders[0].orderID == static_cast<OrderID>(active[0]));
+        CHECK(orders[1].orderID == static_cast<OrderID>(active[1]));
+
+        const auto best = std::to_string(active.front());
+        finder.add(recordFromString("10:00:02.000000;A;" + best + ";C;BUY;" + best + ";1"));
+        active.erase(active.begin());
+    }
+
+    const auto orders = finder.top(symbolFromString("A"));
+    REQUIRE(orders.size() == 1);
+    CHECK(orders[0].orderID == 10);
+}
+
+TEST_CASE("TopKFinder :: Insert after drained top set", "[top-k-finder]")
+{
+    TopKFinder<Side::BUY> finder{1};
+    for (int i = 1; i <= 4; ++i)
+    {
+        finder.add(recordFromString("10:00:00.000000;A;" + std::to_string(i) + ";I;BUY;" + std::to_string(i * 10) + ";1"));
+    }
+    finder.add(recordFromString("10:00:01.000000;A;4;C;BUY;40;1"));
+    finder.add(recordFromString("10:00:01.000000;A;3;C;BUY;30;1"));
+    finder.add(recordFromString("10:00:02.000000;A;5;I;BUY;15;1"));
+    const auto orders = finder.top(symbolFromString("A"));
+
+    REQUIRE(orders.size() == 1);
+    CHECK(orders[0].orderID == 2);
+}
+
+TEST_CASE("TopKFinder :: Amended order leaves top set", "[top-k-finder]")
+{
+    const auto record1 = recordFromString("10:00:00.000000;A;1;I;BUY;5;1");
+    const auto record2 = recordFromString("10:00:01.000000;A;2;I;BUY;3;1");
+    const auto record3 = recordFromString("10:00:02.000000;A;1;A;BUY;1;1");
+
+    TopKFinder<Side::BUY> finder{1};
+    finder.add(record1);
+    finder.add(record2);
+    finder.add(record3);
+    const auto orders = finder.top(record1.symbol);
+
+    REQUIRE(orders.size() == 1);
+    CHECK(orders[0].orderID == record2.orderID);
+    CHECK(orders[0].volume == record2.volume);
+}
+
+TEST_CASE("TopKFinder :: Same as naive top", "[top-k-finder]")
+{
+    constexpr size_t K = 3;
+    TopKFinder<Side::BUY> finder{K};
+    const auto& constFinder = finder;
+    std::map<OrderID, Record> orders;
+    std::mt19937 generator{11};
+    const auto symbol = symbolFromString("A");
+
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        const Record record{Timestamp{i}, symbol, static_cast<OrderID>(generator() % 50), static_cast<Volume>(generator() % 20 + 1), 1,
+                            static_cast<Operation>(generator() % 3), Side::BUY};
+        finder.add(record);
+        if (record.operation == Operation::CANCEL)
+        {
+            orders.erase(record.orderID);
+        }
+        else
+        {
+            orders[record.orderID] = record;
+        }
+
+        // the biggest volumes, ties are not compared as the naive top does not know the insertion order
+        std::vector<Volume> expected;
+        for (const auto& [orderID, order] : orders)
+        {
+            expected.push_back(order.volume);
+        }
+        std::sort(expected.begin(), expected.end(), std::greater<Volume>());
+        expected.resize(std::min(K, expected.size()));
+
+        const auto top = constFinder.top(symbol);
+        REQUIRE(top.size() == expected.size());
+        for (size_t j = 0; j < top.size(); ++j)
+        {
+            REQUIRE(top[j].volume == expected[j]);
+        }
+    }
+}
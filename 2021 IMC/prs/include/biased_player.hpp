@@ -0,0 +1,30 @@
+#pragma once
+
+#include <player.hpp>
+#include <xoshiro.hpp>
+
+#include <cstdint>
+
+// Computer player which prefers some throws over others,
+// weights do not need to sum up to 1.
+class BiasedPlayer final : public Player
+{
+public:
+    BiasedPlayer(std::string name, double paper, double rock, double scissors, uint64_t seed);
+    ~BiasedPlayer() override = default;
+
+    Score numberOfRounds() const override;
+    Throw makeThrow() const override;
+    const std::string& name() const override;
+    void makeThrows(Figure* figures, size_t count) const override;
+
+private:
+    Figure toFigure(uint32_t random) const;
+
+private:
+    std::string mName;
+    // 32 random bits below mRockFrom make paper, below mScissorsFrom - rock, the rest - scissors
+    uint64_t mRockFrom;
+    uint64_t mScissorsFrom;
+    mutable Xoshiro256 mGenerator;
+};
@@ -1,23 +1,25 @@
 #pragma once
 
 #include <player.hpp>
+#include <xoshiro.hpp>
 
-#include <random>
+#include <cstdint>
 
 class ComputerPlayer final : public Player
 {
 public:
     ComputerPlayer();
     ComputerPlayer(std::string name);
+    // Reproducible sequence of throws, e.g. for simulations
+    ComputerPlayer(std::string name, uint64_t seed);
     ~ComputerPlayer() override = default;
 
     Score numberOfRounds() const override;
     Throw makeThrow() const override;
     const std::string& name() const override;
+    void makeThrows(Figure* figures, size_t count) const override;
 
 private:
     std::string mName;
-    std::random_device mRandomDevice;
-    mutable std::mt19937 mGenerator;
-    mutable std::uniform_int_distribution<unsigned> mDistribution;
+    mutable Xoshiro256 mGenerator;
 };
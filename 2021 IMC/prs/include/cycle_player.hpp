@@ -0,0 +1,23 @@
+#pragma once
+
+#include <player.hpp>
+
+#include <vector>
+
+// Player repeating the same sequence of throws over and over again.
+class CyclePlayer final : public Player
+{
+public:
+    CyclePlayer(std::string name, std::vector<Figure> throws);
+    ~CyclePlayer() override = default;
+
+    Score numberOfRounds() const override;
+    Throw makeThrow() const override;
+    const std::string& name() const override;
+    void makeThrows(Figure* figures, size_t count) const override;
+
+private:
+    std::string mName;
+    std::vector<Figure> mThrows;
+    mutable size_t mNextThrow = 0;
+};
@@ -3,6 +3,7 @@
 #include <throw.hpp>
 #include <types.hpp>
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 
@@ -13,6 +14,15 @@ public:
     virtual Score numberOfRounds() const = 0;
     virtual Throw makeThrow() const = 0;
     virtual const std::string& name() const = 0;
+
+    // Makes count throws at once, players override it when they can do it faster.
+    virtual void makeThrows(Figure* figures, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            figures[i] = makeThrow().value();
+        }
+    }
 };
 
 inline std::ostream& operator<<(std::ostream& out, const Player& player)
@@ -3,7 +3,11 @@
 #include <player.hpp>
 #include <types.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <ostream>
+#include <type_traits>
 
 class Referee final
 {
@@ -13,7 +17,19 @@ public:
 
     GameResult playGame(const Player& player1, const Player& player2);
 
+    // Plays the same game as playGame but without any output, for bulk simulations.
+    // Players make all their throws of the game at once.
+    static GameResult simulateGame(const Player& player1, const Player& player2);
+
+    // The same for players of known types, their throws are made without virtual calls.
+    template <typename Player1, typename Player2>
+    static GameResult simulateGame(const Player1& player1, const Player2& player2);
+
 private:
+    using Throws = std::array<Figure, std::numeric_limits<Score>::max()>;
+
+    static void checkPlayers(const Player& player1, const Player& player2);
+    static GameResult scoreRounds(const Throws& throws1, const Throws& throws2, Score rounds);
     void arrangeGame(const Player& player1, const Player& player2);
     void concludeGame(const Player& player1, const Player& player2) const;
     void playRound(Score round, const Player& player1, const Player& player2);
@@ -23,4 +39,22 @@ private:
     Score mRounds = 0;
     Score mWins1 = 0;
     Score mWins2 = 0;
-};
\ No newline at end of file
+};
+
+
+template <typename Player1, typename Player2>
+GameResult Referee::simulateGame(const Player1& player1, const Player2& player2)
+{
+    static_assert(std::is_base_of_v<Player, Player1> && std::is_base_of_v<Player, Player2>, "Only players can play");
+
+    checkPlayers(player1, player2);
+
+    const auto rounds = std::min(player1.Player1::numberOfRounds(), player2.Player2::numberOfRounds());
+
+    Throws throws1;
+    Throws throws2;
+    player1.Player1::makeThrows(throws1.data(), rounds);
+    player2.Player2::makeThrows(throws2.data(), rounds);
+
+    return scoreRounds(throws1, throws2, rounds);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <player.hpp>
+#include <types.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Aggregated results of many games between the same two players.
+struct MatchStats
+{
+    uint64_t games = 0;
+    uint64_t firstPlayerGames = 0;
+    uint64_t secondPlayerGames = 0;
+    uint64_t drawnGames = 0;
+    uint64_t rounds = 0;
+    uint64_t firstPlayerRounds = 0;
+    uint64_t secondPlayerRounds = 0;
+    uint64_t drawnRounds = 0;
+
+    void add(const GameResult& result);
+    void merge(const MatchStats& another);
+    // The same stats as seen by the second player.
+    MatchStats swapped() const;
+};
+
+// Headless round-robin tournament: every pair of entrants plays the given
+// number of games, the games are spread over several threads.
+// Each thread makes its own players with their own seeds and keeps its own
+// stats, so threads share nothing until the stats are merged at the end.
+// Results depend only on the seed and the number of threads.
+class Tournament final
+{
+public:
+    // Makes an independent instance of a strategy from a seed.
+    using PlayerFactory = std::function<std::unique_ptr<Player>(uint64_t seed)>;
+
+    struct Standing
+    {
+        std::string name;
+        uint64_t games = 0;
+        uint64_t wins = 0;
+        uint64_t defeats = 0;
+        uint64_t draws = 0;
+    };
+
+public:
+    // 0 threads means one thread per hardware core.
+    Tournament(unsigned threads, uint64_t seed);
+
+    void addEntrant(std::string name, PlayerFactory factory);
+    void play(uint64_t gamesPerMatch);
+
+    size_t numberOfEntrants() const;
+    unsigned numberOfThreads() const;
+
+    // Stats of all games between two different entrants, from the first one's point of view.
+    MatchStats matchStats(size_t entrant1, size_t entrant2) const;
+    // Entrants sorted by the number of won games.
+    std::vector<Standing> standings() const;
+
+private:
+    struct Entrant
+    {
+        std::string name;
+        PlayerFactory factory;
+    };
+
+    // Stats of all matches, only entries [i][j] with i < j are used.
+    using Results = std::vector<std::vector<MatchStats>>;
+
+    void playShare(unsigned thread, uint64_t gamesPerMatch, Results& results) const;
+    uint64_t playerSeed(unsigned thread, size_t entrant) const;
+
+private:
+    unsigned mThreads;
+    uint64_t mSeed;
+    std::vector<Entrant> mEntrants;
+    Results mResults;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// SplitMix64 step, turns consecutive or poor seeds into well mixed numbers.
+inline uint64_t splitMix64(uint64_t& state)
+{
+    auto value = (state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// xoshiro256** generator by Blackman and Vigna, a few times faster than std::mt19937_64
+// with 32 bytes of state instead of 2.5 KB. Satisfies UniformRandomBitGenerator.
+class Xoshiro256 final
+{
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed)
+    {
+        for (auto& word : mState)
+        {
+            word = splitMix64(seed);
+        }
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const auto result = rotl(mState[1] * 5, 7) * 9;
+        const auto t = mState[1] << 17;
+
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+        mState[2] ^= t;
+        mState[3] = rotl(mState[3], 45);
+
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+private:
+    std::array<uint64_t, 4> mState;
+};
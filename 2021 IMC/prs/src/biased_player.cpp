@@ -0,0 +1,63 @@
+#include <biased_player.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double RANDOM_RANGE = 4294967296.0;
+
+    double checkedTotal(double paper, double rock, double scissors)
+    {
+        if (paper < 0 || rock < 0 || scissors < 0 || paper + rock + scissors <= 0)
+        {
+            throw std::runtime_error("Throw weights must be non-negative and not all zero");
+        }
+        return paper + rock + scissors;
+    }
+}
+
+BiasedPlayer::BiasedPlayer(std::string name, double paper, double rock, double scissors, uint64_t seed)
+    : mName{std::move(name)}
+    , mRockFrom{static_cast<uint64_t>(paper / checkedTotal(paper, rock, scissors) * RANDOM_RANGE)}
+    , mScissorsFrom{static_cast<uint64_t>((paper + rock) / (paper + rock + scissors) * RANDOM_RANGE)}
+    , mGenerator{seed}
+{
+}
+
+Score BiasedPlayer::numberOfRounds() const
+{
+    return std::numeric_limits<Score>::max();
+}
+
+Throw BiasedPlayer::makeThrow() const
+{
+    return Throw{toFigure(static_cast<uint32_t>(mGenerator() >> 32))};
+}
+
+const std::string& BiasedPlayer::name() const
+{
+    return mName;
+}
+
+void BiasedPlayer::makeThrows(Figure* figures, size_t count) const
+{
+    // every random number makes two figures, one from each half
+    size_t i = 0;
+    for (; i + 1 < count; i += 2)
+    {
+        const auto random = mGenerator();
+        figures[i] = toFigure(static_cast<uint32_t>(random));
+        figures[i + 1] = toFigure(static_cast<uint32_t>(random >> 32));
+    }
+
+    if (i < count)
+    {
+        figures[i] = toFigure(static_cast<uint32_t>(mGenerator() >> 32));
+    }
+}
+
+Figure BiasedPlayer::toFigure(uint32_t random) const
+{
+    return static_cast<Figure>((random >= mRockFrom) + (random >= mScissorsFrom));
+}
@@ -1,12 +1,24 @@
 #include <computer_player.hpp>
 
 #include <limits>
+#include <random>
 
 namespace
 {
-    constexpr unsigned MIN_VALUE = 1;
-    constexpr unsigned MAX_VALUE = 3;
     const std::string DEFAULT_COMPUTER_NAME = "Computer";
+
+    uint64_t randomSeed()
+    {
+        std::random_device randomDevice;
+        return (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+    }
+
+    // Maps 32 random bits to one of 3 figures with a multiplication instead of a division,
+    // the bias is 2^-32 and the mapping has no branches.
+    Figure toFigure(uint32_t random)
+    {
+        return static_cast<Figure>((static_cast<uint64_t>(random) * 3) >> 32);
+    }
 }
 
 ComputerPlayer::ComputerPlayer()
@@ -15,9 +27,13 @@ ComputerPlayer::ComputerPlayer()
 }
 
 ComputerPlayer::ComputerPlayer(std::string name)
+    : ComputerPlayer{std::move(name), randomSeed()}
+{
+}
+
+ComputerPlayer::ComputerPlayer(std::string name, uint64_t seed)
     : mName{std::move(name)}
-    , mGenerator{mRandomDevice()}
-    , mDistribution{MIN_VALUE, MAX_VALUE}
+    , mGenerator{seed}
 {
 }
 
@@ -28,20 +44,27 @@ Score ComputerPlayer::numberOfRounds() const
 
 Throw ComputerPlayer::makeThrow() const
 {
-    switch (mDistribution(mGenerator))
-    {
-        case MIN_VALUE:
-            return Throw{Figure::PAPER};
-
-        case MAX_VALUE:
-            return Throw{Figure::SCISSORS};
-
-        default:
-            return Throw{Figure::ROCK};
-    }
+    return Throw{toFigure(static_cast<uint32_t>(mGenerator() >> 32))};
 }
 
 const std::string& ComputerPlayer::name() const
 {
     return mName;
 }
+
+void ComputerPlayer::makeThrows(Figure* figures, size_t count) const
+{
+    // every random number makes two figures, one from each half
+    size_t i = 0;
+    for (; i + 1 < count; i += 2)
+    {
+        const auto random = mGenerator();
+        figures[i] = toFigure(static_cast<uint32_t>(random));
+        figures[i + 1] = toFigure(static_cast<uint32_t>(random >> 32));
+    }
+
+    if (i < count)
+    {
+        figures[i] = toFigure(static_cast<uint32_t>(mGenerator() >> 32));
+    }
+}
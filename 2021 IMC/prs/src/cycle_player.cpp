@@ -0,0 +1,40 @@
+#include <cycle_player.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+CyclePlayer::CyclePlayer(std::string name, std::vector<Figure> throws)
+    : mName{std::move(name)}
+    , mThrows{std::move(throws)}
+{
+    if (mThrows.empty())
+    {
+        throw std::runtime_error("Sequence of throws cannot be empty");
+    }
+}
+
+Score CyclePlayer::numberOfRounds() const
+{
+    return std::numeric_limits<Score>::max();
+}
+
+Throw CyclePlayer::makeThrow() const
+{
+    const auto figure = mThrows[mNextThrow];
+    mNextThrow = mNextThrow + 1 == mThrows.size() ? 0 : mNextThrow + 1;
+    return Throw{figure};
+}
+
+const std::string& CyclePlayer::name() const
+{
+    return mName;
+}
+
+void CyclePlayer::makeThrows(Figure* figures, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        figures[i] = mThrows[mNextThrow];
+        mNextThrow = mNextThrow + 1 == mThrows.size() ? 0 : mNextThrow + 1;
+    }
+}
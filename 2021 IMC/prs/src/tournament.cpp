@@ -0,0 +1,185 @@
+#include <referee.hpp>
+#include <tournament.hpp>
+#include <xoshiro.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+void MatchStats::add(const GameResult& result)
+{
+    ++games;
+    if (result.firstPlayerWins > result.secondPlayerWins)
+    {
+        ++firstPlayerGames;
+    }
+    else if (result.firstPlayerWins < result.secondPlayerWins)
+    {
+        ++secondPlayerGames;
+    }
+    else
+    {
+        ++drawnGames;
+    }
+
+    rounds += result.numberOfRounds;
+    firstPlayerRounds += result.firstPlayerWins;
+    secondPlayerRounds += result.secondPlayerWins;
+    drawnRounds += result.draws;
+}
+
+void MatchStats::merge(const MatchStats& another)
+{
+    games += another.games;
+    firstPlayerGames += another.firstPlayerGames;
+    secondPlayerGames += another.secondPlayerGames;
+    drawnGames += another.drawnGames;
+    rounds += another.rounds;
+    firstPlayerRounds += another.firstPlayerRounds;
+    secondPlayerRounds += another.secondPlayerRounds;
+    drawnRounds += another.drawnRounds;
+}
+
+MatchStats MatchStats::swapped() const
+{
+    auto result = *this;
+    std::swap(result.firstPlayerGames, result.secondPlayerGames);
+    std::swap(result.firstPlayerRounds, result.secondPlayerRounds);
+    return result;
+}
+
+Tournament::Tournament(unsigned threads, uint64_t seed)
+    : mThreads{threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads}
+    , mSeed{seed}
+{
+}
+
+void Tournament::addEntrant(std::string name, PlayerFactory factory)
+{
+    mEntrants.push_back(Entrant{std::move(name), std::move(factory)});
+}
+
+void Tournament::play(uint64_t gamesPerMatch)
+{
+    const auto entrants = mEntrants.size();
+    std::vector<Results> threadResults(mThreads, Results(entrants, std::vector<MatchStats>(entrants)));
+    std::vector<std::exception_ptr> errors(mThreads);
+
+    std::vector<std::thread> threads;
+    threads.reserve(mThreads);
+    for (unsigned thread = 0; thread < mThreads; ++thread)
+    {
+        threads.emplace_back([this, thread, gamesPerMatch, &threadResults, &errors]
+        {
+            try
+            {
+                playShare(thread, gamesPerMatch, threadResults[thread]);
+            }
+            catch (...)
+            {
+                errors[thread] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    mResults.assign(entrants, std::vector<MatchStats>(entrants));
+    for (const auto& results : threadResults)
+    {
+        for (size_t i = 0; i < entrants; ++i)
+        {
+            for (size_t j = i + 1; j < entrants; ++j)
+            {
+                mResults[i][j].merge(results[i][j]);
+            }
+        }
+    }
+}
+
+size_t Tournament::numberOfEntrants() const
+{
+    return mEntrants.size();
+}
+
+unsigned Tournament::numberOfThreads() const
+{
+    return mThreads;
+}
+
+MatchStats Tournament::matchStats(size_t entrant1, size_t entrant2) const
+{
+    if (entrant1 == entrant2 || entrant1 >= mResults.size() || entrant2 >= mResults.size())
+    {
+        throw std::runtime_error("No match between these entrants");
+    }
+
+    return entrant1 < entrant2 ? mResults[entrant1][entrant2] : mResults[entrant2][entrant1].swapped();
+}
+
+std::vector<Tournament::Standing> Tournament::standings() const
+{
+    std::vector<Standing> result;
+    for (size_t i = 0; i < mResults.size(); ++i)
+    {
+        Standing standing{mEntrants[i].name};
+        for (size_t j = 0; j < mResults.size(); ++j)
+        {
+            if (i != j)
+            {
+                const auto stats = matchStats(i, j);
+                standing.games += stats.games;
+                standing.wins += stats.firstPlayerGames;
+                standing.defeats += stats.secondPlayerGames;
+                standing.draws += stats.drawnGames;
+            }
+        }
+        result.push_back(std::move(standing));
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.wins > b.wins; });
+    return result;
+}
+
+void Tournament::playShare(unsigned thread, uint64_t gamesPerMatch, Results& results) const
+{
+    std::vector<std::unique_ptr<Player>> players;
+    players.reserve(mEntrants.size());
+    for (size_t i = 0; i < mEntrants.size(); ++i)
+    {
+        players.push_back(mEntrants[i].factory(playerSeed(thread, i)));
+    }
+
+    const auto games = gamesPerMatch / mThreads + (thread < gamesPerMatch % mThreads ? 1 : 0);
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        for (size_t j = i + 1; j < players.size(); ++j)
+        {
+            // accumulate locally, so threads do not write to the neighbouring memory on every game
+            MatchStats stats;
+            for (uint64_t game = 0; game < games; ++game)
+            {
+                stats.add(Referee::simulateGame(*players[i], *players[j]));
+            }
+            results[i][j] = stats;
+        }
+    }
+}
+
+uint64_t Tournament::playerSeed(unsigned thread, size_t entrant) const
+{
+    auto index = static_cast<uint64_t>(thread) * mEntrants.size() + entrant;
+    auto seed = mSeed ^ splitMix64(index);
+    return splitMix64(seed);
+}
@@ -0,0 +1,69 @@
+#include <biased_player.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+TEST_CASE("BiasedPlayer :: Name and Number of Rounds", "[biased-player]")
+{
+    const BiasedPlayer player{"Biased", 1, 1, 1, 0};
+    CHECK(player.name() == "Biased");
+    CHECK(player.numberOfRounds() > 0);
+}
+
+TEST_CASE("BiasedPlayer :: Single Throw", "[biased-player]")
+{
+    const auto figure = GENERATE(Figure::PAPER, Figure::ROCK, Figure::SCISSORS);
+    const BiasedPlayer player{"Biased",
+                              figure == Figure::PAPER ? 1.0 : 0.0,
+                              figure == Figure::ROCK ? 1.0 : 0.0,
+                              figure == Figure::SCISSORS ? 1.0 : 0.0,
+                              1};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(player.makeThrow().value() == figure);
+    }
+}
+
+TEST_CASE("BiasedPlayer :: Seeded Throws", "[biased-player]")
+{
+    const BiasedPlayer player1{"Player1", 1, 2, 3, 42};
+    const BiasedPlayer player2{"Player2", 1, 2, 3, 42};
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(player1.makeThrow().value() == player2.makeThrow().value());
+    }
+}
+
+TEST_CASE("BiasedPlayer :: Invalid Weights", "[biased-player]")
+{
+    CHECK_THROWS(BiasedPlayer{"Biased", 0, 0, 0, 0});
+    CHECK_THROWS(BiasedPlayer{"Biased", -1, 1, 1, 0});
+}
+
+TEST_CASE("BiasedPlayer :: Make Throws", "[biased-player]")
+{
+    const BiasedPlayer player{"Biased", 1, 2, 1, 3};
+
+    std::vector<Figure> figures(40001);
+    player.makeThrows(figures.data(), figures.size());
+
+    size_t counts[3] = {0, 0, 0};
+    for (const auto figure : figures)
+    {
+        if (figure == Figure::PAPER || figure == Figure::ROCK || figure == Figure::SCISSORS)
+        {
+            ++counts[static_cast<size_t>(figure)];
+        }
+    }
+    CHECK(counts[0] + counts[1] + counts[2] == figures.size());
+
+    // expected 10000 papers and scissors and 20000 rocks, standard deviations are below 100
+    CHECK(counts[0] > 9500);
+    CHECK(counts[0] < 10500);
+    CHECK(counts[1] > 19500);
+    CHECK(counts[1] < 20500);
+    CHECK(counts[2] > 9500);
+    CHECK(counts[2] < 10500);
+}
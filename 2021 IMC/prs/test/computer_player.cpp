@@ -2,6 +2,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <vector>
+
 TEST_CASE("ComputerPlayer :: Custom Name", "[computer-player]")
 {
     const std::string expectedName = "Machine";
@@ -30,3 +32,54 @@ TEST_CASE("ComputerPlayer :: Make Throw", "[computer-player]")
         CHECK((thrw.value() == Figure::PAPER || thrw.value() == Figure::ROCK || thrw.value() == Figure::SCISSORS));
     }
 }
+
+TEST_CASE("ComputerPlayer :: Seeded Throws", "[computer-player]")
+{
+    const ComputerPlayer player1{"Player1", 42};
+    const ComputerPlayer player2{"Player2", 42};
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(player1.makeThrow().value() == player2.makeThrow().value());
+    }
+}
+
+TEST_CASE("ComputerPlayer :: Make Throws", "[computer-player]")
+{
+    const auto count = GENERATE(size_t{0}, size_t{1}, size_t{254}, size_t{255}, size_t{30000});
+    const ComputerPlayer player{"Player", 7};
+
+    std::vector<Figure> figures(count);
+    player.makeThrows(figures.data(), figures.size());
+
+    size_t counts[3] = {0, 0, 0};
+    for (const auto figure : figures)
+    {
+        if (figure == Figure::PAPER || figure == Figure::ROCK || figure == Figure::SCISSORS)
+        {
+            ++counts[static_cast<size_t>(figure)];
+        }
+    }
+    CHECK(counts[0] + counts[1] + counts[2] == count);
+
+    if (count >= 30000)
+    {
+        // each figure is expected 10000 times, standard deviation is about 82
+        for (const auto figureCount : counts)
+        {
+            CHECK(figureCount > 9500);
+            CHECK(figureCount < 10500);
+        }
+    }
+}
+
+TEST_CASE("ComputerPlayer :: Seeded Batches", "[computer-player]")
+{
+    const ComputerPlayer player1{"Player1", 42};
+    const ComputerPlayer player2{"Player2", 42};
+
+    std::vector<Figure> figures1(101);
+    std::vector<Figure> figures2(101);
+    player1.makeThrows(figures1.data(), figures1.size());
+    player2.makeThrows(figures2.data(), figures2.size());
+    CHECK(figures1 == figures2);
+}
@@ -0,0 +1,38 @@
+#include <cycle_player.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("CyclePlayer :: Name and Number of Rounds", "[cycle-player]")
+{
+    const CyclePlayer player{"Cycle", {Figure::ROCK}};
+    CHECK(player.name() == "Cycle");
+    CHECK(player.numberOfRounds() > 0);
+}
+
+TEST_CASE("CyclePlayer :: Repeats Throws", "[cycle-player]")
+{
+    const std::vector<Figure> throws{Figure::PAPER, Figure::PAPER, Figure::SCISSORS};
+    const CyclePlayer player{"Cycle", throws};
+    for (size_t i = 0; i < 10 * throws.size(); ++i)
+    {
+        CHECK(player.makeThrow().value() == throws[i % throws.size()]);
+    }
+}
+
+TEST_CASE("CyclePlayer :: No Throws", "[cycle-player]")
+{
+    CHECK_THROWS(CyclePlayer{"Cycle", {}});
+}
+
+TEST_CASE("CyclePlayer :: Make Throws", "[cycle-player]")
+{
+    const std::vector<Figure> throws{Figure::ROCK, Figure::PAPER};
+    const CyclePlayer player{"Cycle", throws};
+
+    // a single throw first, so the batch starts in the middle of the sequence
+    CHECK(player.makeThrow().value() == Figure::ROCK);
+
+    std::vector<Figure> figures(5);
+    player.makeThrows(figures.data(), figures.size());
+    CHECK(figures == std::vector<Figure>{Figure::PAPER, Figure::ROCK, Figure::PAPER, Figure::ROCK, Figure::PAPER});
+}
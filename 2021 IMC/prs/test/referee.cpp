@@ -1,3 +1,5 @@
+#include <computer_player.hpp>
+#include <cycle_player.hpp>
 #include <player.hpp>
 #include <referee.hpp>
 #include <throw.hpp>
@@ -160,3 +162,52 @@ TEST_CASE("Referee :: Single Player", "[referee]")
 
     CHECK_THROWS(referee.playGame(player, player));
 }
+
+TEST_CASE("Referee :: Simulate Game", "[referee]")
+{
+    const PlayerMock player1{"Player1", 5, {Figure::PAPER, Figure::SCISSORS, Figure::ROCK, Figure::PAPER, Figure::SCISSORS}};
+    const PlayerMock player2{"Player2", 4, {Figure::SCISSORS, Figure::PAPER, Figure::ROCK, Figure::ROCK}};
+
+    const auto result = Referee::simulateGame(player1, player2);
+    CHECK(result.numberOfRounds == 4);
+    CHECK(result.firstPlayerWins == 2);
+    CHECK(result.secondPlayerWins == 1);
+    CHECK(result.draws == 1);
+
+    CHECK_THROWS(Referee::simulateGame(player1, player1));
+}
+
+TEST_CASE("Referee :: Simulate Game of Known Players", "[referee]")
+{
+    const ComputerPlayer player1{"Player1", 1};
+    const ComputerPlayer player2{"Player2", 2};
+    const ComputerPlayer sameAsPlayer1{"Player1", 1};
+    const ComputerPlayer sameAsPlayer2{"Player2", 2};
+
+    for (int game = 0; game < 10; ++game)
+    {
+        const auto fastResult = Referee::simulateGame(player1, player2);
+        const auto virtualResult = Referee::simulateGame(static_cast<const Player&>(sameAsPlayer1), static_cast<const Player&>(sameAsPlayer2));
+
+        CHECK(fastResult.numberOfRounds == virtualResult.numberOfRounds);
+        CHECK(fastResult.firstPlayerWins == virtualResult.firstPlayerWins);
+        CHECK(fastResult.secondPlayerWins == virtualResult.secondPlayerWins);
+        CHECK(fastResult.draws == virtualResult.draws);
+        CHECK(fastResult.numberOfRounds == fastResult.firstPlayerWins + fastResult.secondPlayerWins + fastResult.draws);
+    }
+
+    CHECK_THROWS(Referee::simulateGame(player1, player1));
+}
+
+TEST_CASE("Referee :: Simulate Game of All Throw Pairs", "[referee]")
+{
+    const CyclePlayer player1{"Player1", {Figure::PAPER, Figure::PAPER, Figure::PAPER, Figure::ROCK, Figure::ROCK, Figure::ROCK, Figure::SCISSORS, Figure::SCISSORS, Figure::SCISSORS}};
+    const CyclePlayer player2{"Player2", {Figure::PAPER, Figure::ROCK, Figure::SCISSORS}};
+
+    // 255 rounds are 28 full cycles of 9 throw pairs and 3 more rounds of paper against every figure
+    const auto result = Referee::simulateGame(player1, player2);
+    CHECK(result.numberOfRounds == 255);
+    CHECK(result.firstPlayerWins == 28 * 3 + 1);
+    CHECK(result.secondPlayerWins == 28 * 3 + 1);
+    CHECK(result.draws == 28 * 3 + 1);
+}
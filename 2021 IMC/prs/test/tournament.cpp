@@ -0,0 +1,112 @@
+#include <biased_player.hpp>
+#include <computer_player.hpp>
+#include <cycle_player.hpp>
+#include <tournament.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+namespace
+{
+    Tournament::PlayerFactory cycle(std::string name, std::vector<Figure> throws)
+    {
+        return [name, throws](uint64_t)
+        {
+            return std::make_unique<CyclePlayer>(name, throws);
+        };
+    }
+
+    Tournament::PlayerFactory random(std::string name)
+    {
+        return [name](uint64_t seed)
+        {
+            return std::make_unique<ComputerPlayer>(name, seed);
+        };
+    }
+}
+
+TEST_CASE("Tournament :: Deterministic Players", "[tournament]")
+{
+    const auto threads = GENERATE(1u, 3u);
+    Tournament tournament{threads, 0};
+    tournament.addEntrant("Paper", cycle("Paper", {Figure::PAPER}));
+    tournament.addEntrant("Rock", cycle("Rock", {Figure::ROCK}));
+    tournament.addEntrant("Scissors", cycle("Scissors", {Figure::SCISSORS}));
+
+    const uint64_t games = 10;
+    tournament.play(games);
+
+    const auto paperRock = tournament.matchStats(0, 1);
+    CHECK(paperRock.games == games);
+    CHECK(paperRock.firstPlayerGames == games);
+    CHECK(paperRock.secondPlayerGames == 0);
+    CHECK(paperRock.rounds == games * 255);
+    CHECK(paperRock.firstPlayerRounds == paperRock.rounds);
+
+    const auto rockPaper = tournament.matchStats(1, 0);
+    CHECK(rockPaper.secondPlayerGames == games);
+    CHECK(rockPaper.firstPlayerGames == 0);
+
+    CHECK(tournament.matchStats(2, 0).firstPlayerGames == games);
+    CHECK(tournament.matchStats(1, 2).firstPlayerGames == games);
+
+    for (const auto& standing : tournament.standings())
+    {
+        CHECK(standing.games == 2 * games);
+        CHECK(standing.wins == games);
+        CHECK(standing.defeats == games);
+        CHECK(standing.draws == 0);
+    }
+
+    CHECK_THROWS_AS(tournament.matchStats(0, 0), std::runtime_error);
+    CHECK_THROWS_AS(tournament.matchStats(0, 3), std::runtime_error);
+}
+
+TEST_CASE("Tournament :: Games Are Split Between Threads", "[tournament]")
+{
+    Tournament tournament{4, 7};
+    tournament.addEntrant("Random1", random("Random1"));
+    tournament.addEntrant("Random2", random("Random2"));
+
+    const uint64_t games = 1001;
+    tournament.play(games);
+
+    const auto stats = tournament.matchStats(0, 1);
+    CHECK(stats.games == games);
+    CHECK(stats.firstPlayerGames + stats.secondPlayerGames + stats.drawnGames == games);
+    CHECK(stats.rounds == games * 255);
+    CHECK(stats.firstPlayerRounds + stats.secondPlayerRounds + stats.drawnRounds == stats.rounds);
+}
+
+TEST_CASE("Tournament :: Same Seed Same Results", "[tournament]")
+{
+    auto playTournament = [](uint64_t seed)
+    {
+        Tournament tournament{2, seed};
+        tournament.addEntrant("Random", random("Random"));
+        tournament.addEntrant("Rock lover", [](uint64_t playerSeed)
+        {
+            return std::make_unique<BiasedPlayer>("Rock lover", 1, 2, 1, playerSeed);
+        });
+        tournament.play(100);
+        return tournament.matchStats(0, 1);
+    };
+
+    const auto stats1 = playTournament(5);
+    const auto stats2 = playTournament(5);
+    CHECK(stats1.firstPlayerRounds == stats2.firstPlayerRounds);
+    CHECK(stats1.secondPlayerRounds == stats2.secondPlayerRounds);
+    CHECK(stats1.drawnRounds == stats2.drawnRounds);
+}
+
+TEST_CASE("Tournament :: Factory Error", "[tournament]")
+{
+    Tournament tournament{2, 0};
+    tournament.addEntrant("Broken", [](uint64_t) -> std::unique_ptr<Player>
+    {
+        throw std::runtime_error("Cannot make a player");
+    });
+
+    CHECK_THROWS_AS(tournament.play(1), std::runtime_error);
+}
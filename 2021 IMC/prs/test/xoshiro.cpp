@@ -0,0 +1,41 @@
+#include <xoshiro.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+TEST_CASE("Xoshiro :: SplitMix64 Reference Values", "[xoshiro]")
+{
+    uint64_t state = 0;
+    CHECK(splitMix64(state) == 0xE220A8397B1DCDAFull);
+    CHECK(splitMix64(state) == 0x6E789E6AA1B965F4ull);
+    CHECK(splitMix64(state) == 0x06C45D188009454Full);
+}
+
+TEST_CASE("Xoshiro :: Same Seed Same Numbers", "[xoshiro]")
+{
+    Xoshiro256 generator1{42};
+    Xoshiro256 generator2{42};
+    Xoshiro256 generator3{43};
+
+    bool differs = false;
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto value = generator1();
+        CHECK(value == generator2());
+        differs = differs || value != generator3();
+    }
+    CHECK(differs);
+}
+
+TEST_CASE("Xoshiro :: Standard Distributions", "[xoshiro]")
+{
+    Xoshiro256 generator{1};
+    std::uniform_int_distribution<int> distribution{1, 6};
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto value = distribution(generator);
+        CHECK(value >= 1);
+        CHECK(value <= 6);
+    }
+}
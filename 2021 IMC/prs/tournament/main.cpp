@@ -0,0 +1,136 @@
+#include <biased_player.hpp>
+#include <computer_player.hpp>
+#include <cycle_player.hpp>
+#include <tournament.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        uint64_t games = 100000;
+        unsigned threads = 0;
+        uint64_t seed = 1;
+    };
+
+    Options parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string name = argv[i];
+            if (i + 1 == argc)
+            {
+                throw std::runtime_error("No value for option " + name);
+            }
+            const std::string value = argv[++i];
+
+            if (name == "--games")
+            {
+                options.games = std::stoull(value);
+            }
+            else if (name == "--threads")
+            {
+                options.threads = static_cast<unsigned>(std::stoul(value));
+            }
+            else if (name == "--seed")
+            {
+                options.seed = std::stoull(value);
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option " + name);
+            }
+        }
+        return options;
+    }
+
+    void addEntrants(Tournament& tournament)
+    {
+        tournament.addEntrant("Random", [](uint64_t seed)
+        {
+            return std::make_unique<ComputerPlayer>("Random", seed);
+        });
+        tournament.addEntrant("Rock lover", [](uint64_t seed)
+        {
+            return std::make_unique<BiasedPlayer>("Rock lover", 0.2, 0.6, 0.2, seed);
+        });
+        tournament.addEntrant("No scissors", [](uint64_t seed)
+        {
+            return std::make_unique<BiasedPlayer>("No scissors", 0.5, 0.5, 0.0, seed);
+        });
+        tournament.addEntrant("Always rock", [](uint64_t)
+        {
+            return std::make_unique<CyclePlayer>("Always rock", std::vector<Figure>{Figure::ROCK});
+        });
+        tournament.addEntrant("Cycle", [](uint64_t)
+        {
+            return std::make_unique<CyclePlayer>("Cycle", std::vector<Figure>{Figure::PAPER, Figure::ROCK, Figure::SCISSORS});
+        });
+    }
+
+    void printStandings(const Tournament& tournament)
+    {
+        std::cout << std::left << std::setw(16) << "Entrant"
+                  << std::right << std::setw(14) << "games"
+                  << std::setw(14) << "wins"
+                  << std::setw(14) << "defeats"
+                  << std::setw(14) << "draws"
+                  << std::setw(10) << "win %" << "\n";
+
+        for (const auto& standing : tournament.standings())
+        {
+            const auto winRate = standing.games == 0 ? 0.0 : 100.0 * standing.wins / standing.games;
+            std::cout << std::left << std::setw(16) << standing.name
+                      << std::right << std::setw(14) << standing.games
+                      << std::setw(14) << standing.wins
+                      << std::setw(14) << standing.defeats
+                      << std::setw(14) << standing.draws
+                      << std::setw(10) << std::fixed << std::setprecision(2) << winRate << "\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto options = parseOptions(argc, argv);
+
+        Tournament tournament{options.threads, options.seed};
+        addEntrants(tournament);
+
+        const auto matches = tournament.numberOfEntrants() * (tournament.numberOfEntrants() - 1) / 2;
+        std::cout << "Entrants: " << tournament.numberOfEntrants() << ", games per match: " << options.games
+                  << ", threads: " << tournament.numberOfThreads() << ", seed: " << options.seed << "\n\n";
+
+        const auto start = Clock::now();
+        tournament.play(options.games);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        printStandings(tournament);
+
+        const auto games = matches * options.games;
+        std::cout << "\n" << games << " games in " << std::fixed << std::setprecision(2) << elapsed.count() << " s, "
+                  << static_cast<double>(games) / elapsed.count() / 1e6 << " Mgames/s" << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " [--games N] [--threads N] [--seed N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+// Copies of the queues from ConcurrentQueue_clean.cpp and ConcurrentQueue_fast.cpp
+// without their main() functions, so they can be benchmarked side by side with
+// the library queues. The only changes are the namespaces and the removed name
+// of an unused parameter (the library is built with -Werror).
+// The fast queue needs C++20 (std::atomic_flag::test) and supports one consumer only.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace clean
+{
+
+template<typename T, uint64_t SIZE = 4096, uint64_t MAX_PUSH_ATTEMPTS = 40000000>
+class ConcurrentQueue {
+private:
+    static constexpr unsigned Log2(unsigned n, unsigned p = 0) {
+        return (n <= 1) ? p : Log2(n / 2, p + 1);
+    }
+
+    static constexpr uint64_t closestExponentOf2(uint64_t) {
+        return (1UL << ((uint64_t)(Log2(SIZE - 1)) + 1));
+    }
+
+    static constexpr uint64_t mRingModMask = closestExponentOf2(SIZE) - 1;
+    static constexpr uint64_t mSize = closestExponentOf2(SIZE);
+
+    T mMem[mSize];
+    mutable std::mutex mLock;
+    uint64_t mReadPtr = 0;
+    uint64_t mWritePtr = 0;
+
+public:
+    bool try_pop(T& aResult) {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (!peek()) {
+            return false;
+        }
+
+        aResult = mMem[mReadPtr & mRingModMask];
+        mReadPtr++;
+        return true;
+    }
+
+    bool try_push(const T& aItem) {
+        for (uint64_t attempt = 0; attempt < MAX_PUSH_ATTEMPTS; ++attempt) {
+            std::lock_guard<std::mutex> lock(mLock);
+            if (getCount() == mSize) {
+                continue;
+            }
+
+            mMem[mWritePtr & mRingModMask] = aItem;
+            mWritePtr++;
+            return true;
+        }
+        return false;
+    }
+
+    bool try_push(T&& aItem) {
+        for (uint64_t attempt = 0; attempt < MAX_PUSH_ATTEMPTS; ++attempt) {
+            std::lock_guard<std::mutex> lock(mLock);
+            if (getCount() == mSize) {
+                continue;
+            }
+
+            mMem[mWritePtr & mRingModMask] = std::move(aItem);
+            mWritePtr++;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    bool peek() const {
+        return (mWritePtr != mReadPtr);
+    }
+
+    uint64_t getCount() const {
+        return mWritePtr - mReadPtr;
+    }
+};
+
+}
+
+namespace fast
+{
+
+template<typename T, uint64_t SIZE = 4096, uint64_t MAX_PUSH_ATTEMPTS = 40000000>
+class ConcurrentQueue {
+private:
+    static constexpr unsigned Log2(unsigned n, unsigned p = 0) {
+        return (n <= 1) ? p : Log2(n / 2, p + 1);
+    }
+
+    static constexpr uint64_t closestExponentOf2(uint64_t) {
+        return (1UL << ((uint64_t)(Log2(SIZE - 1)) + 1));
+    }
+
+    static constexpr uint64_t mRingModMask = closestExponentOf2(SIZE) - 1;
+    static constexpr uint64_t mSize = closestExponentOf2(SIZE);
+
+    std::pair<std::atomic_flag, T> mMem[mSize];
+    std::atomic_uint64_t mReadPtr{0};
+    std::atomic_uint64_t mWritePtr{0};
+
+public:
+    bool try_pop(T& aResult) {
+        auto& pair = mMem[mReadPtr & mRingModMask];
+        if (!pair.first.test()) {
+            return false;
+        }
+
+        aResult = pair.second;
+        pair.first.clear();
+        ++mReadPtr;
+        return true;
+    }
+
+    bool try_push(const T& aItem) {
+        const auto writePos = mWritePtr++;
+
+        for (uint64_t attempt = 0; attempt < MAX_PUSH_ATTEMPTS; ++attempt) {
+            if (writePos >= mReadPtr + mSize) {
+                continue;
+            }
+            auto& pair = mMem[writePos & mRingModMask];
+            pair.second = aItem;
+            pair.first.test_and_set();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool try_push(T&& aItem) {
+        const auto writePos = mWritePtr++;
+
+        for (uint64_t attempt = 0; attempt < MAX_PUSH_ATTEMPTS; ++attempt) {
+            if (writePos >= mReadPtr + mSize) {
+                continue;
+            }
+            auto& pair = mMem[writePos & mRingModMask];
+            pair.second = std::move(aItem);
+            pair.first.test_and_set();
+            return true;
+        }
+
+        return false;
+    }
+};
+
+}
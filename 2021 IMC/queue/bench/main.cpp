@@ -0,0 +1,507 @@
+#include "legacy_queues.hpp"
+
+#include <mpmc_queue.hpp>
+#include <segmented_queue.hpp>
+#include <spsc_queue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t CAPACITY = 1024;
+    constexpr uint64_t STOP = std::numeric_limits<uint64_t>::max();
+
+    struct Options
+    {
+        uint64_t items = 1000000;
+        uint64_t roundTrips = 100000;
+        size_t batch = 32;
+        size_t payload = 16;
+        unsigned threads = 4;
+        bool pin = false;
+        std::string topology = "all";
+    };
+
+    struct Topology
+    {
+        std::string name;
+        unsigned producers;
+        unsigned consumers;
+    };
+
+    // Items are at least 16 bytes: a sequence number and a producer index.
+    template <size_t SIZE>
+    struct Payload
+    {
+        static_assert(SIZE >= 16, "Payload must hold a sequence number and a producer index");
+
+        uint64_t sequence = 0;
+        uint64_t producer = 0;
+        std::array<char, SIZE - 16> padding{};
+    };
+
+    // Per thread failed operation counters, each on its own cache line.
+    struct alignas(CACHE_LINE_SIZE) Counters
+    {
+        uint64_t failedPushes = 0;
+        uint64_t failedPops = 0;
+    };
+
+    struct ThroughputResult
+    {
+        double itemsPerSecond;
+        uint64_t failedPushes;
+        uint64_t failedPops;
+    };
+
+    struct LatencyResult
+    {
+        std::vector<double> percentiles;
+        double max;
+    };
+
+    struct Percentile
+    {
+        const char* name;
+        double value;
+    };
+
+    const std::vector<Percentile> PERCENTILES = {{"p50", 50}, {"p90", 90}, {"p99", 99}, {"p99.9", 99.9}};
+
+    Options parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string name = argv[i];
+            if (name == "--pin")
+            {
+                options.pin = true;
+                continue;
+            }
+
+            if (i + 1 == argc)
+            {
+                throw std::runtime_error("No value for option " + name);
+            }
+            const std::string value = argv[++i];
+
+            if (name == "--items")
+            {
+                options.items = std::stoull(value);
+            }
+            else if (name == "--round-trips")
+            {
+                options.roundTrips = std::stoull(value);
+            }
+            else if (name == "--batch")
+            {
+                options.batch = std::max<size_t>(1, std::stoul(value));
+            }
+            else if (name == "--payload")
+            {
+                options.payload = std::stoul(value);
+            }
+            else if (name == "--threads")
+            {
+                options.threads = static_cast<unsigned>(std::max<unsigned long>(2, std::stoul(value)));
+            }
+            else if (name == "--topology")
+            {
+                options.topology = value;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option " + name);
+            }
+        }
+        return options;
+    }
+
+    void pinThread(unsigned index, bool pin)
+    {
+#ifdef __linux__
+        if (!pin)
+        {
+            return;
+        }
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+        (void)index;
+        (void)pin;
+#endif
+    }
+
+    // Producers push items until all are pushed, then every consumer gets a STOP item.
+    // With BULK producers push batches with try_push_bulk and consumers take them with drain,
+    // a consumer may drain several STOP items then, so all of them stop once all STOPs are seen.
+    template <typename Queue, typename Item, bool BULK = false>
+    ThroughputResult measureThroughput(const Topology& topology, const Options& options)
+    {
+        auto queue = std::make_unique<Queue>();
+        const auto itemsPerProducer = options.items / topology.producers;
+        const auto numberOfThreads = topology.producers + topology.consumers;
+
+        std::vector<Counters> counters(numberOfThreads);
+        std::atomic<bool> started{false};
+        std::atomic<unsigned> stops{0};
+
+        const auto push = [&](const Item& item, Counters& threadCounters)
+        {
+            while (!queue->try_push(item))
+            {
+                ++threadCounters.failedPushes;
+                std::this_thread::yield();
+            }
+        };
+
+        std::vector<std::thread> producers;
+        for (unsigned p = 0; p < topology.producers; ++p)
+        {
+            producers.emplace_back([&, p]
+            {
+                pinThread(p, options.pin);
+                while (!started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                if constexpr (BULK)
+                {
+                    std::vector<Item> batch(options.batch);
+                    for (uint64_t i = 0; i < itemsPerProducer;)
+                    {
+                        const auto size = std::min<uint64_t>(options.batch, itemsPerProducer - i);
+                        for (uint64_t j = 0; j < size; ++j)
+                        {
+                            batch[j].producer = p;
+                            batch[j].sequence = i + j;
+                        }
+
+                        for (uint64_t pushed = 0; pushed < size;)
+                        {
+                            const auto count = queue->try_push_bulk(batch.begin() + static_cast<ptrdiff_t>(pushed),
+                                                                    batch.begin() + static_cast<ptrdiff_t>(size));
+                            if (count == 0)
+                            {
+                                ++counters[p].failedPushes;
+                                std::this_thread::yield();
+                            }
+                            pushed += count;
+                        }
+                        i += size;
+                    }
+                }
+                else
+                {
+                    Item item;
+                    item.producer = p;
+                    for (uint64_t i = 0; i < itemsPerProducer; ++i)
+                    {
+                        item.sequence = i;
+                        push(item, counters[p]);
+                    }
+                }
+            });
+        }
+
+        std::vector<std::thread> consumers;
+        for (unsigned c = 0; c < topology.consumers; ++c)
+        {
+            consumers.emplace_back([&, c]
+            {
+                const auto index = topology.producers + c;
+                pinThread(index, options.pin);
+
+                if constexpr (BULK)
+                {
+                    const auto countStops = [&](const Item& item)
+                    {
+                        if (item.sequence == STOP)
+                        {
+                            stops.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    };
+
+                    while (stops.load(std::memory_order_relaxed) < topology.consumers)
+                    {
+                        if (queue->drain(countStops, options.batch) == 0)
+                        {
+                            ++counters[index].failedPops;
+                            std::this_thread::yield();
+                        }
+                    }
+                    return;
+                }
+
+                Item item;
+                while (true)
+                {
+                    if (queue->try_pop(item))
+                    {
+                        if (item.sequence == STOP)
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        ++counters[index].failedPops;
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        const auto start = Clock::now();
+        started.store(true, std::memory_order_release);
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        Item stop;
+        stop.sequence = STOP;
+        Counters stopCounters;
+        for (unsigned c = 0; c < topology.consumers; ++c)
+        {
+            push(stop, stopCounters);
+        }
+
+        for (auto& consumer : consumers)
+        {
+            consumer.join();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        ThroughputResult result{static_cast<double>(itemsPerProducer * topology.producers) / elapsed.count(), 0, 0};
+        for (const auto& threadCounters : counters)
+        {
+            result.failedPushes += threadCounters.failedPushes;
+            result.failedPops += threadCounters.failedPops;
+        }
+        return result;
+    }
+
+    // One item at a time goes to an echo thread and back through a second queue.
+    template <typename Queue, typename Item>
+    LatencyResult measureRoundTrip(const Options& options)
+    {
+        auto requests = std::make_unique<Queue>();
+        auto responses = std::make_unique<Queue>();
+
+        std::thread echo([&]
+        {
+            pinThread(1, options.pin);
+
+            Item item;
+            while (true)
+            {
+                if (!requests->try_pop(item))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                while (!responses->try_push(item))
+                {
+                    std::this_thread::yield();
+                }
+                if (item.sequence == STOP)
+                {
+                    break;
+                }
+            }
+        });
+
+        pinThread(0, options.pin);
+
+        std::vector<double> latencies;
+        latencies.reserve(options.roundTrips);
+
+        Item item;
+        for (uint64_t i = 0; i <= options.roundTrips; ++i)
+        {
+            item.sequence = i == options.roundTrips ? STOP : i;
+
+            const auto start = Clock::now();
+            while (!requests->try_push(item))
+            {
+                std::this_thread::yield();
+            }
+            while (!responses->try_pop(item))
+            {
+                std::this_thread::yield();
+            }
+            const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+            if (item.sequence != STOP)
+            {
+                latencies.push_back(elapsed.count());
+            }
+        }
+        echo.join();
+
+        LatencyResult result{{}, 0};
+        if (latencies.empty())
+        {
+            return result;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        for (const auto percentile : PERCENTILES)
+        {
+            const auto index = static_cast<size_t>(percentile.value / 100 * static_cast<double>(latencies.size() - 1));
+            result.percentiles.push_back(latencies[index]);
+        }
+        result.max = latencies.back();
+        return result;
+    }
+
+    void printThroughput(const std::string& topology, const std::string& queue, const ThroughputResult& result)
+    {
+        std::cout << std::left << std::setw(12) << topology
+                  << std::setw(22) << queue
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << result.itemsPerSecond / 1e6
+                  << std::setw(16) << result.failedPushes
+                  << std::setw(16) << result.failedPops << "\n";
+    }
+
+    void printLatency(const std::string& queue, const LatencyResult& result)
+    {
+        std::cout << std::left << std::setw(22) << queue << std::right << std::fixed << std::setprecision(0);
+        for (const auto value : result.percentiles)
+        {
+            std::cout << std::setw(12) << value;
+        }
+        std::cout << std::setw(12) << result.max << "\n";
+    }
+
+    template <typename Item>
+    void runBenchmarks(const Options& options)
+    {
+        using Clean = clean::ConcurrentQueue<Item, CAPACITY>;
+        using Fast = fast::ConcurrentQueue<Item, CAPACITY>;
+        using Spsc = SpscQueue<Item, CAPACITY>;
+        using Mpmc = MpmcQueue<Item, CAPACITY>;
+        using Segmented = SegmentedQueue<Item, CAPACITY>;
+
+        const auto half = std::max(1u, options.threads / 2);
+        const std::vector<Topology> topologies = {
+            {"1p1c", 1, 1},
+            {"np1c", options.threads - 1, 1},
+            {"1pnc", 1, options.threads - 1},
+            {"npnc", half, half},
+        };
+
+        std::cout << "Throughput:\n"
+                  << std::left << std::setw(12) << "topology"
+                  << std::setw(22) << "queue"
+                  << std::right << std::setw(12) << "Mitems/s"
+                  << std::setw(16) << "failed pushes"
+                  << std::setw(16) << "failed pops" << "\n";
+
+        for (const auto& topology : topologies)
+        {
+            if (options.topology != "all" && options.topology != topology.name)
+            {
+                continue;
+            }
+
+            const auto name = topology.name == "1p1c" ? topology.name
+                                                      : topology.name + " (" + std::to_string(topology.producers) + "/" + std::to_string(topology.consumers) + ")";
+
+            printThroughput(name, "mutex (clean)", measureThroughput<Clean, Item>(topology, options));
+            if (topology.consumers == 1)
+            {
+                printThroughput(name, "atomic_flag (fast)", measureThroughput<Fast, Item>(topology, options));
+            }
+            if (topology.producers == 1 && topology.consumers == 1)
+            {
+                printThroughput(name, "SpscQueue", measureThroughput<Spsc, Item>(topology, options));
+            }
+            printThroughput(name, "MpmcQueue", measureThroughput<Mpmc, Item>(topology, options));
+            printThroughput(name, "SegmentedQueue", measureThroughput<Segmented, Item>(topology, options));
+            if (topology.producers == 1 && topology.consumers == 1)
+            {
+                printThroughput(name, "SpscQueue bulk", measureThroughput<Spsc, Item, true>(topology, options));
+            }
+            printThroughput(name, "MpmcQueue bulk", measureThroughput<Mpmc, Item, true>(topology, options));
+        }
+
+        std::cout << "\nRound trip latency, ns:\n" << std::left << std::setw(22) << "queue" << std::right;
+        for (const auto percentile : PERCENTILES)
+        {
+            std::cout << std::setw(12) << percentile.name;
+        }
+        std::cout << std::setw(12) << "max" << "\n";
+
+        printLatency("mutex (clean)", measureRoundTrip<Clean, Item>(options));
+        printLatency("atomic_flag (fast)", measureRoundTrip<Fast, Item>(options));
+        printLatency("SpscQueue", measureRoundTrip<Spsc, Item>(options));
+        printLatency("MpmcQueue", measureRoundTrip<Mpmc, Item>(options));
+        printLatency("SegmentedQueue", measureRoundTrip<Segmented, Item>(options));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto options = parseOptions(argc, argv);
+
+        std::cout << "Payload: " << options.payload << " bytes, items: " << options.items
+                  << ", round trips: " << options.roundTrips << ", batch: " << options.batch << ", threads: " << options.threads
+                  << ", pinning: " << (options.pin ? "on" : "off") << "\n\n";
+
+        switch (options.payload)
+        {
+            case 16:
+                runBenchmarks<Payload<16>>(options);
+                break;
+            case 64:
+                runBenchmarks<Payload<64>>(options);
+                break;
+            case 256:
+                runBenchmarks<Payload<256>>(options);
+                break;
+            default:
+                throw std::runtime_error("Supported payload sizes are 16, 64 and 256 bytes");
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " [--items N] [--round-trips N] [--payload 16|64|256] [--threads N]"
+                  << " [--batch N] [--topology all|1p1c|np1c|1pnc|npnc] [--pin]" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
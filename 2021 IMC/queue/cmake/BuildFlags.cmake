@@ -0,0 +1,51 @@
+IF (NOT CMAKE_BUILD_TYPE)
+    SET (CMAKE_BUILD_TYPE RELEASE)
+ENDIF ()
+
+MESSAGE ("-- Build type: ${CMAKE_BUILD_TYPE}")
+
+IF (CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
+    ADD_COMPILE_OPTIONS (-std=c++17)
+
+    ADD_COMPILE_OPTIONS (-Wall)
+    ADD_COMPILE_OPTIONS (-Wcast-align)
+    ADD_COMPILE_OPTIONS (-Wcast-qual)
+    ADD_COMPILE_OPTIONS (-Werror)
+    ADD_COMPILE_OPTIONS (-Wextra)
+    ADD_COMPILE_OPTIONS (-Wfloat-equal)
+    ADD_COMPILE_OPTIONS (-Wpedantic)
+    ADD_COMPILE_OPTIONS (-Wredundant-decls)
+    ADD_COMPILE_OPTIONS (-Wshadow)
+    ADD_COMPILE_OPTIONS (-Wunused)
+
+    SET (CMAKE_CXX_FLAGS_RELEASE "-O3 -funroll-loops")
+    SET (CMAKE_CXX_FLAGS_DEBUG   "-O0 -ggdb -g3")
+
+    # instrumented build, e.g. -DSANITIZER=thread
+    SET (SANITIZER "" CACHE STRING "Sanitizer to build with: thread, address or undefined")
+    IF (SANITIZER)
+        MESSAGE ("-- Sanitizer: ${SANITIZER}")
+        ADD_COMPILE_OPTIONS (-fsanitize=${SANITIZER} -fno-omit-frame-pointer -g)
+        SET (CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -fsanitize=${SANITIZER}")
+
+        # GCC warns that ThreadSanitizer does not model fences (they only order wake-ups and
+        # the deque's owner/thief race, data is published with release/acquire),
+        # and gives false maybe-uninitialized warnings in instrumented std::function
+        IF (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            ADD_COMPILE_OPTIONS (-Wno-tsan -Wno-maybe-uninitialized)
+        ENDIF ()
+    ENDIF ()
+
+ELSEIF (CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
+    ADD_COMPILE_OPTIONS (/std:c++17)
+
+    ADD_COMPILE_OPTIONS (/W3)
+    ADD_COMPILE_OPTIONS (/WX)
+    ADD_COMPILE_OPTIONS (/MP)
+
+    SET (CMAKE_CXX_FLAGS_RELEASE "/O2 /Ob2")
+    SET (CMAKE_CXX_FLAGS_DEBUG   "/Od /Zi")
+
+    ADD_DEFINITIONS(-D_CRT_SECURE_NO_WARNINGS)
+
+ENDIF ()
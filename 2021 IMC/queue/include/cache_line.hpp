@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+// std::hardware_destructive_interference_size is not reliably available,
+// 64 bytes is the cache line size of all supported x86-64 and ARM64 CPUs.
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+constexpr bool isPowerOfTwo(size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
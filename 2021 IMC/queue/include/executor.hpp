@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cache_line.hpp>
+#include <inplace_task.hpp>
+#include <mpmc_queue.hpp>
+#include <wait_strategy.hpp>
+#include <work_stealing_deque.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Thread pool running void() tasks.
+//
+// Every worker has its own work-stealing deque: tasks submitted from inside a
+// task go to the bottom of the current worker's deque and are run LIFO, idle
+// workers steal from the top of other deques. Tasks submitted from outside go
+// to a shared MPMC injection queue. Tasks are stored in the queue slots by
+// value as InplaceTask, a one cache line object, so submitting a task never
+// allocates. A lambda capturing more than TASK_SIZE bytes does not compile,
+// callers box big captures themselves, e.g. into a unique_ptr.
+// Idle workers spin for a while and then park until something is submitted.
+// Tasks must not throw, an escaping exception terminates the program.
+class Executor final
+{
+public:
+    static constexpr size_t DEQUE_CAPACITY = 1024;
+    static constexpr size_t INJECTION_CAPACITY = 4096;
+    static constexpr size_t TASK_SIZE = CACHE_LINE_SIZE - sizeof(void*);
+
+    using Task = InplaceTask<TASK_SIZE>;
+    static_assert(sizeof(Task) == CACHE_LINE_SIZE, "Task must take exactly one cache line");
+
+public:
+    explicit Executor(size_t numberOfThreads = std::max(1u, std::thread::hardware_concurrency()))
+        : mInjection{std::make_unique<InjectionQueue>()}
+    {
+        for (size_t i = 0; i < std::max<size_t>(1, numberOfThreads); ++i)
+        {
+            mWorkers.push_back(std::make_unique<Worker>(this, i));
+        }
+        for (auto& worker : mWorkers)
+        {
+            worker->thread = std::thread([this, &worker = *worker]{ run(worker); });
+        }
+    }
+
+    // Runs all submitted tasks before stopping the workers.
+    ~Executor()
+    {
+        wait();
+
+        mStopping.store(true, std::memory_order_release);
+        mWorkAvailable.notify();
+        for (auto& worker : mWorkers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    size_t numberOfThreads() const
+    {
+        return mWorkers.size();
+    }
+
+    // Can be called from any thread including the executor's tasks.
+    // Blocks an outside caller while the injection queue is full.
+    template <typename F>
+    void submit(F&& function)
+    {
+        static_assert(Task::fits<std::decay_t<F>>(), "Task captures too much, box the captures explicitly");
+
+        mPending.fetch_add(1, std::memory_order_relaxed);
+        Task task{std::forward<F>(function)};
+
+        auto* worker = currentWorker();
+        if (worker && worker->executor == this)
+        {
+            if (!worker->deque.try_push(std::move(task)) && !mInjection->try_push(std::move(task)))
+            {
+                // both queues are full, waiting for them from a worker may deadlock
+                execute(task);
+                return;
+            }
+        }
+        else
+        {
+            mInjection->push(std::move(task));
+        }
+
+        mWorkAvailable.notify();
+    }
+
+    // Waits until all submitted tasks, including the ones they submit, are done.
+    // Must not be called from the executor's tasks.
+    void wait()
+    {
+        YieldingWait{}.wait([this]{ return mPending.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    using InjectionQueue = MpmcQueue<Task, INJECTION_CAPACITY, YieldingWait>;
+
+    struct Worker
+    {
+        Worker(Executor* owner, size_t workerIndex)
+            : executor{owner}
+            , index{workerIndex}
+            , random{workerIndex + 1}
+        {
+        }
+
+        WorkStealingDeque<Task, DEQUE_CAPACITY> deque;
+        Executor* executor;
+        size_t index;
+        uint64_t random;
+        std::thread thread;
+    };
+
+    static Worker*& currentWorker()
+    {
+        static thread_local Worker* worker = nullptr;
+        return worker;
+    }
+
+    void run(Worker& worker)
+    {
+        currentWorker() = &worker;
+
+        Task task;
+        while (true)
+        {
+            if (!findTask(worker, task))
+            {
+                mWorkAvailable.wait([&]{ return findTask(worker, task) || mStopping.load(std::memory_order_acquire); });
+                if (!task)
+                {
+                    break;
+                }
+            }
+            execute(task);
+        }
+
+        currentWorker() = nullptr;
+    }
+
+    // Own deque first, then the injection queue, then other workers starting from a random one.
+    bool findTask(Worker& worker, Task& task)
+    {
+        if (worker.deque.try_pop(task) || mInjection->try_pop(task))
+        {
+            return true;
+        }
+
+        const auto numberOfWorkers = mWorkers.size();
+        const auto start = static_cast<size_t>(nextRandom(worker.random) % numberOfWorkers);
+        for (size_t i = 0; i < numberOfWorkers; ++i)
+        {
+            auto& victim = *mWorkers[(start + i) % numberOfWorkers];
+            if (&victim != &worker && victim.deque.try_steal(task))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Destroys the task and its captures before it is counted as done.
+    void execute(Task& task)
+    {
+        task();
+        task = Task{};
+        mPending.fetch_sub(1, std::memory_order_release);
+    }
+
+    // xorshift64
+    static uint64_t nextRandom(uint64_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+private:
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::unique_ptr<InjectionQueue> mInjection;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> mPending{0};
+    std::atomic<bool> mStopping{false};
+    ParkingWait mWorkAvailable;
+};
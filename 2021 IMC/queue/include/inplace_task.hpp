@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only void() callable stored entirely inside the object, with no heap fallback:
+// a callable bigger than SIZE bytes, over-aligned or with a throwing move
+// constructor is a compilation error.
+//
+// Callables which are trivially copyable and destructible (e.g. lambdas
+// capturing only numbers and pointers) are moved with a plain memcpy of the
+// storage, so such tasks can be put into queue slots as cheaply as raw pointers
+// but without allocating and deleting every task. An empty task must not be called.
+template <size_t SIZE>
+class InplaceTask final
+{
+    static_assert(SIZE >= sizeof(void*), "Storage must be at least pointer size");
+
+public:
+    static constexpr size_t size()
+    {
+        return SIZE;
+    }
+
+    template <typename Callable>
+    static constexpr bool fits()
+    {
+        return sizeof(Callable) <= SIZE
+            && alignof(Callable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+public:
+    InplaceTask() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceTask>>>
+    InplaceTask(F&& function)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(std::is_invocable_r_v<void, Callable&>, "Task must be callable without arguments");
+        static_assert(fits<Callable>(), "Callable does not fit into InplaceTask, capture less or increase the size");
+
+        new (mStorage) Callable(std::forward<F>(function));
+        mOperations = &OPERATIONS<Callable>;
+    }
+
+    InplaceTask(InplaceTask&& another) noexcept
+    {
+        moveFrom(another);
+    }
+
+    InplaceTask& operator=(InplaceTask&& another) noexcept
+    {
+        if (this != &another)
+        {
+            reset();
+            moveFrom(another);
+        }
+        return *this;
+    }
+
+    InplaceTask(const InplaceTask&) = delete;
+    InplaceTask& operator=(const InplaceTask&) = delete;
+
+    ~InplaceTask()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return mOperations != nullptr;
+    }
+
+    void operator()()
+    {
+        mOperations->invoke(mStorage);
+    }
+
+private:
+    // move and destroy are null for trivial callables
+    struct Operations
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename Callable>
+    static constexpr bool TRIVIAL = std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>;
+
+    template <typename Callable>
+    static constexpr Operations OPERATIONS = {
+        [](void* storage) { (*std::launder(static_cast<Callable*>(storage)))(); },
+        TRIVIAL<Callable> ? nullptr : +[](void* from, void* to)
+        {
+            auto* source = std::launder(static_cast<Callable*>(from));
+            new (to) Callable(std::move(*source));
+            source->~Callable();
+        },
+        TRIVIAL<Callable> ? nullptr : +[](void* storage) { std::launder(static_cast<Callable*>(storage))->~Callable(); },
+    };
+
+    void moveFrom(InplaceTask& another)
+    {
+        if (!another.mOperations)
+        {
+            return;
+        }
+
+        if (another.mOperations->move)
+        {
+            another.mOperations->move(another.mStorage, mStorage);
+        }
+        else
+        {
+            std::memcpy(mStorage, another.mStorage, SIZE);
+        }
+        mOperations = std::exchange(another.mOperations, nullptr);
+    }
+
+    void reset()
+    {
+        if (mOperations)
+        {
+            if (mOperations->destroy)
+            {
+                mOperations->destroy(mStorage);
+            }
+            mOperations = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char mStorage[SIZE];
+    const Operations* mOperations = nullptr;
+};
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cache_line.hpp>
+#include <queue_stats.hpp>
+#include <wait_strategy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free queue for any number of producers and consumers
+// (Dmitry Vyukov's design).
+//
+// Every slot has a sequence number telling whose turn it is: a slot at
+// position pos is free for the producer of pos when sequence == pos and holds
+// an item for the consumer of pos when sequence == pos + 1. After consuming,
+// the sequence becomes pos + CAPACITY, i.e. the slot is free for the next lap.
+// Positions are claimed with a CAS, so a stalled thread never makes another
+// one read or overwrite its slot, and positions never repeat (no ABA).
+// Blocking push and pop wait according to WaitStrategy (see wait_strategy.hpp),
+// operations are counted by Stats (see queue_stats.hpp).
+// All memory is inside the object, nothing is allocated after construction.
+template <typename T, size_t CAPACITY, typename WaitStrategy = BusySpinWait, typename Stats = NoStats>
+class MpmcQueue final
+{
+    static_assert(isPowerOfTwo(CAPACITY) && CAPACITY >= 2, "Capacity must be a power of two, at least 2");
+    static_assert(std::is_default_constructible_v<T>, "Elements must be default constructible");
+
+public:
+    using value_type = T;
+
+    MpmcQueue()
+    {
+        for (size_t i = 0; i < CAPACITY; ++i)
+        {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return CAPACITY;
+    }
+
+    bool try_push(const T& item)
+    {
+        return emplace(item);
+    }
+
+    bool try_push(T&& item)
+    {
+        return emplace(std::move(item));
+    }
+
+    // Waits for a free slot.
+    void push(const T& item)
+    {
+        waitAndCount(mStats, QueueSide::PRODUCER, mNotFull, [&]{ return try_push(item); });
+    }
+
+    void push(T&& item)
+    {
+        waitAndCount(mStats, QueueSide::PRODUCER, mNotFull, [&]{ return try_push(std::move(item)); });
+    }
+
+    // Pushes items from [first, last) into consecutive positions claimed with one CAS,
+    // as many as there are free slots. Returns the number of pushed items.
+    template <typename ForwardIt>
+    size_t try_push_bulk(ForwardIt first, ForwardIt last)
+    {
+        const auto [pos, count] = claim(mTail, QueueSide::PRODUCER, static_cast<size_t>(std::distance(first, last)));
+        for (size_t i = 0; i < count; ++i, ++first)
+        {
+            auto& slot = mSlots[(pos + i) & MASK];
+            slot.value = *first;
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+
+        if (count != 0)
+        {
+            pushed(pos, count);
+            mNotEmpty.notify();
+        }
+        return count;
+    }
+
+    bool try_pop(T& result)
+    {
+        auto pos = mHead.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& slot = mSlots[pos & MASK];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    result = std::move(slot.value);
+                    slot.sequence.store(pos + CAPACITY, std::memory_order_release);
+                    mStats.completed(QueueSide::CONSUMER, 1);
+                    mNotFull.notify();
+                    return true;
+                }
+                mStats.casRetry(QueueSide::CONSUMER);
+            }
+            else if (diff < 0)
+            {
+                // the slot has not been written in this lap yet
+                mStats.failed(QueueSide::CONSUMER);
+                return false;
+            }
+            else
+            {
+                mStats.casRetry(QueueSide::CONSUMER);
+                pos = mHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Waits for an item.
+    void pop(T& result)
+    {
+        waitAndCount(mStats, QueueSide::CONSUMER, mNotEmpty, [&]{ return try_pop(result); });
+    }
+
+    // Claims up to max consecutive items with one CAS and calls callback(T&) for
+    // each of them in place. Returns the number of processed items.
+    // The callback must not throw.
+    template <typename Callback>
+    size_t drain(Callback&& callback, size_t max = std::numeric_limits<size_t>::max())
+    {
+        const auto [pos, count] = claim(mHead, QueueSide::CONSUMER, max);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& slot = mSlots[(pos + i) & MASK];
+            callback(slot.value);
+            slot.sequence.store(pos + i + CAPACITY, std::memory_order_release);
+        }
+
+        if (count != 0)
+        {
+            mStats.completed(QueueSide::CONSUMER, count);
+            mNotFull.notify();
+        }
+        return count;
+    }
+
+    // Approximate if called concurrently with push or pop.
+    size_t size() const
+    {
+        const auto head = mHead.load(std::memory_order_acquire);
+        const auto tail = mTail.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    const Stats& stats() const
+    {
+        return mStats;
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    template <typename U>
+    bool emplace(U&& item)
+    {
+        auto pos = mTail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& slot = mSlots[pos & MASK];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::forward<U>(item);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    pushed(pos, 1);
+                    mNotEmpty.notify();
+                    return true;
+                }
+                mStats.casRetry(QueueSide::PRODUCER);
+            }
+            else if (diff < 0)
+            {
+                // the slot still holds an item of the previous lap
+                mStats.failed(QueueSide::PRODUCER);
+                return false;
+            }
+            else
+            {
+                mStats.casRetry(QueueSide::PRODUCER);
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Counts pushed items, the head is loaded only when occupancy is sampled.
+    void pushed(size_t pos, size_t count)
+    {
+        mStats.completed(QueueSide::PRODUCER, count);
+        if (mStats.sampleOccupancy(pos, count))
+        {
+            const auto head = mHead.load(std::memory_order_relaxed);
+            mStats.occupancy(pos + count > head ? pos + count - head : 0);
+        }
+    }
+
+    // Claims up to max consecutive positions from index, whose slots are free for the producer
+    // or full for the consumer side. Returns the first position and the number of claimed ones.
+    std::pair<size_t, size_t> claim(std::atomic<size_t>& index, QueueSide side, size_t max)
+    {
+        max = std::min(max, CAPACITY);
+        if (max == 0)
+        {
+            return {0, 0};
+        }
+
+        // a free slot has sequence == position, a full one position + 1
+        const size_t offset = side == QueueSide::PRODUCER ? 0 : 1;
+        auto pos = index.load(std::memory_order_relaxed);
+        while (true)
+        {
+            size_t count = 0;
+            intptr_t diff = 0;
+            for (; count < max; ++count)
+            {
+                const auto sequence = mSlots[(pos + count) & MASK].sequence.load(std::memory_order_acquire);
+                diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + count + offset);
+                if (diff != 0)
+                {
+                    break;
+                }
+            }
+
+            if (count != 0)
+            {
+                if (index.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                {
+                    return {pos, count};
+                }
+                mStats.casRetry(side);
+            }
+            else if (diff < 0)
+            {
+                // full for producers, empty for consumers
+                mStats.failed(side);
+                return {pos, 0};
+            }
+            else
+            {
+                mStats.casRetry(side);
+                pos = index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> mTail{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> mHead{0};
+    WaitStrategy mNotEmpty;
+    WaitStrategy mNotFull;
+    Stats mStats;
+    alignas(CACHE_LINE_SIZE) std::array<Slot, CAPACITY> mSlots;
+};
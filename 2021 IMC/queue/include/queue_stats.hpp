@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cache_line.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Statistics policies of the queues.
+//
+// A queue reports every operation to its Stats template parameter:
+//   void completed(QueueSide side, size_t count); // pushed or popped items
+//   void failed(QueueSide side);                  // try_push on a full or try_pop on an empty queue
+//   void casRetry(QueueSide side);                // lost a race for a position
+//   void stalled(QueueSide side, std::chrono::nanoseconds time); // blocking push or pop waited
+//   bool sampleOccupancy(size_t first, size_t count) const;      // whether to report occupancy()
+//   void occupancy(size_t items);
+// The default NoStats compiles all of it away.
+enum class QueueSide
+{
+    PRODUCER,
+    CONSUMER,
+};
+
+
+struct NoStats
+{
+    static constexpr bool ENABLED = false;
+
+    void completed(QueueSide, size_t) {}
+    void failed(QueueSide) {}
+    void casRetry(QueueSide) {}
+    void stalled(QueueSide, std::chrono::nanoseconds) {}
+    bool sampleOccupancy(size_t, size_t) const { return false; }
+    void occupancy(size_t) {}
+};
+
+
+// Counters sharded by thread and side, every shard on its own cache line, so
+// threads of one side rarely share a line and producers never share one with
+// consumers. Occupancy is sampled once per OCCUPANCY_SAMPLE_PERIOD pushes.
+// snapshot() can be called from any thread at any time, e.g. by a monitoring
+// thread; concurrently updated counters are read relaxed, without stopping anybody.
+class QueueStats final
+{
+public:
+    static constexpr bool ENABLED = true;
+    static constexpr size_t SHARDS = 16;
+    static constexpr size_t OCCUPANCY_SAMPLE_PERIOD = 64;
+
+    struct Snapshot
+    {
+        uint64_t pushes = 0;
+        uint64_t pops = 0;
+        uint64_t failedPushes = 0;
+        uint64_t failedPops = 0;
+        uint64_t pushCasRetries = 0;
+        uint64_t popCasRetries = 0;
+        std::chrono::nanoseconds producerStall{0};
+        std::chrono::nanoseconds consumerStall{0};
+        uint64_t highWaterMark = 0;
+    };
+
+public:
+    void completed(QueueSide side, size_t count)
+    {
+        shard(side).operations.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void failed(QueueSide side)
+    {
+        shard(side).failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void casRetry(QueueSide side)
+    {
+        shard(side).casRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void stalled(QueueSide side, std::chrono::nanoseconds time)
+    {
+        shard(side).stallNs.fetch_add(static_cast<uint64_t>(time.count()), std::memory_order_relaxed);
+    }
+
+    // Whether positions [first, first + count) cross a multiple of the period.
+    bool sampleOccupancy(size_t first, size_t count) const
+    {
+        return first / OCCUPANCY_SAMPLE_PERIOD != (first + count) / OCCUPANCY_SAMPLE_PERIOD;
+    }
+
+    void occupancy(size_t items)
+    {
+        auto current = mHighWaterMark.load(std::memory_order_relaxed);
+        while (items > current && !mHighWaterMark.compare_exchange_weak(current, items, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Snapshot snapshot() const
+    {
+        Snapshot result;
+        for (size_t i = 0; i < SHARDS; ++i)
+        {
+            result.pushes += mProducers[i].operations.load(std::memory_order_relaxed);
+            result.failedPushes += mProducers[i].failures.load(std::memory_order_relaxed);
+            result.pushCasRetries += mProducers[i].casRetries.load(std::memory_order_relaxed);
+            result.producerStall += std::chrono::nanoseconds{mProducers[i].stallNs.load(std::memory_order_relaxed)};
+
+            result.pops += mConsumers[i].operations.load(std::memory_order_relaxed);
+            result.failedPops += mConsumers[i].failures.load(std::memory_order_relaxed);
+            result.popCasRetries += mConsumers[i].casRetries.load(std::memory_order_relaxed);
+            result.consumerStall += std::chrono::nanoseconds{mConsumers[i].stallNs.load(std::memory_order_relaxed)};
+        }
+        result.highWaterMark = mHighWaterMark.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        std::atomic<uint64_t> operations{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> casRetries{0};
+        std::atomic<uint64_t> stallNs{0};
+    };
+
+    Shard& shard(QueueSide side)
+    {
+        static thread_local const size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % SHARDS;
+        return side == QueueSide::PRODUCER ? mProducers[index] : mConsumers[index];
+    }
+
+private:
+    std::array<Shard, SHARDS> mProducers;
+    std::array<Shard, SHARDS> mConsumers;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> mHighWaterMark{0};
+};
+
+
+// Waits until ready() returns true, if the first attempt fails and statistics
+// are enabled, the whole wait is reported as a stall of the side.
+template <typename Stats, typename WaitStrategy, typename Predicate>
+void waitAndCount(Stats& stats, QueueSide side, WaitStrategy& strategy, Predicate&& ready)
+{
+    if constexpr (Stats::ENABLED)
+    {
+        if (ready())
+        {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        strategy.wait(ready);
+        stats.stalled(side, std::chrono::steady_clock::now() - start);
+    }
+    else
+    {
+        strategy.wait(ready);
+    }
+}
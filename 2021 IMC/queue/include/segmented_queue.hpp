@@ -0,0 +1,368 @@
+#pragma once
+
+#include <cache_line.hpp>
+#include <wait_strategy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Unbounded lock-free queue for any number of producers and consumers, made of
+// linked fixed-size segments (FAA array queue by Ramalhete and Correia).
+//
+// Producers and consumers claim slots of the tail and head segments with
+// fetch_add. A consumer which overtakes a producer marks the slot as taken and
+// the producer retries with the next one. When the tail segment is used up,
+// a producer links a new one, so try_push fails only if memory runs out.
+// Consumed segments are reclaimed with hazard pointers and recycled through a
+// small free list, which is touched once per SEGMENT_SIZE items.
+// Up to MAX_THREADS threads may use a queue at the same time.
+template <typename T, size_t SEGMENT_SIZE = 1024>
+class SegmentedQueue final
+{
+    static_assert(SEGMENT_SIZE >= 2, "Segment must have at least 2 slots");
+    static_assert(std::is_default_constructible_v<T>, "Elements must be default constructible");
+
+public:
+    static constexpr size_t MAX_THREADS = 128;
+    static constexpr size_t MAX_FREE_SEGMENTS = 16;
+
+public:
+    SegmentedQueue()
+    {
+        auto* segment = new Segment;
+        mHead.store(segment, std::memory_order_relaxed);
+        mTail.store(segment, std::memory_order_relaxed);
+    }
+
+    SegmentedQueue(const SegmentedQueue&) = delete;
+    SegmentedQueue& operator=(const SegmentedQueue&) = delete;
+
+    ~SegmentedQueue()
+    {
+        for (auto* segment = mHead.load(std::memory_order_relaxed); segment;)
+        {
+            delete std::exchange(segment, segment->next.load(std::memory_order_relaxed));
+        }
+        for (auto& record : mRecords)
+        {
+            for (auto* segment : record.retired)
+            {
+                delete segment;
+            }
+        }
+        for (auto* segment : mFreeSegments)
+        {
+            delete segment;
+        }
+    }
+
+    bool try_push(const T& item)
+    {
+        return emplace(T{item});
+    }
+
+    bool try_push(T&& item)
+    {
+        return emplace(std::move(item));
+    }
+
+    bool try_pop(T& result)
+    {
+        Guard guard{*this};
+        auto& hazard = guard.record.hazards[HEAD_HAZARD];
+
+        while (true)
+        {
+            auto* head = protect(mHead, hazard);
+            if (head->dequeueIndex.load(std::memory_order_acquire) >= head->enqueueIndex.load(std::memory_order_acquire)
+                && head->next.load(std::memory_order_acquire) == nullptr)
+            {
+                return false;
+            }
+
+            const auto index = head->dequeueIndex.fetch_add(1, std::memory_order_acq_rel);
+            if (index >= SEGMENT_SIZE)
+            {
+                auto* next = head->next.load(std::memory_order_acquire);
+                if (!next)
+                {
+                    return false;
+                }
+
+                // the tail must not stay on a segment which is about to be retired
+                auto* tail = head;
+                mTail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+
+                auto* expected = head;
+                if (mHead.compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+                {
+                    hazard.store(nullptr, std::memory_order_release);
+                    retire(guard.record, head);
+                }
+                continue;
+            }
+
+            auto& slot = head->slots[index];
+            auto state = EMPTY;
+            if (slot.state.compare_exchange_strong(state, TAKEN, std::memory_order_acq_rel))
+            {
+                // overtook the producer of this slot, it will retry with another one
+                continue;
+            }
+
+            // the producer has claimed the slot and is writing the item
+            while (state != READY)
+            {
+                cpuRelax();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+
+            result = std::move(slot.value);
+            return true;
+        }
+    }
+
+    // Approximate if called concurrently with push or pop.
+    bool empty() const
+    {
+        const auto* head = mHead.load(std::memory_order_acquire);
+        return head->dequeueIndex.load(std::memory_order_acquire) >= head->enqueueIndex.load(std::memory_order_acquire)
+            && head->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // Segments in the free list, for tests and monitoring.
+    size_t freeSegments() const
+    {
+        std::lock_guard<std::mutex> lock{mFreeSegmentsMutex};
+        return mFreeSegments.size();
+    }
+
+private:
+    enum State : uint8_t
+    {
+        EMPTY,
+        WRITING,
+        READY,
+        TAKEN,
+    };
+
+    struct Slot
+    {
+        std::atomic<State> state{EMPTY};
+        T value;
+    };
+
+    struct Segment
+    {
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueueIndex{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeueIndex{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<Segment*> next{nullptr};
+        std::array<Slot, SEGMENT_SIZE> slots;
+    };
+
+    static constexpr size_t TAIL_HAZARD = 0;
+    static constexpr size_t HEAD_HAZARD = 1;
+
+    // Hazard pointers and retired segments of one thread, owned while active is set.
+    struct alignas(CACHE_LINE_SIZE) Record
+    {
+        std::atomic<bool> active{false};
+        std::array<std::atomic<Segment*>, 2> hazards{};
+        std::vector<Segment*> retired;
+    };
+
+    // Owns a record for the duration of one operation.
+    struct Guard
+    {
+        explicit Guard(SegmentedQueue& owner)
+            : record{owner.acquireRecord()}
+        {
+        }
+
+        ~Guard()
+        {
+            for (auto& hazard : record.hazards)
+            {
+                hazard.store(nullptr, std::memory_order_release);
+            }
+            record.active.store(false, std::memory_order_release);
+        }
+
+        Record& record;
+    };
+
+    bool emplace(T&& item)
+    {
+        Guard guard{*this};
+        auto& hazard = guard.record.hazards[TAIL_HAZARD];
+
+        while (true)
+        {
+            auto* tail = protect(mTail, hazard);
+            const auto index = tail->enqueueIndex.fetch_add(1, std::memory_order_acq_rel);
+
+            if (index < SEGMENT_SIZE)
+            {
+                auto& slot = tail->slots[index];
+                auto state = EMPTY;
+                if (slot.state.compare_exchange_strong(state, WRITING, std::memory_order_acq_rel))
+                {
+                    slot.value = std::move(item);
+                    slot.state.store(READY, std::memory_order_release);
+                    return true;
+                }
+                // a consumer has taken the slot, try the next one
+                continue;
+            }
+
+            if (tail != mTail.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            auto* next = tail->next.load(std::memory_order_acquire);
+            if (next)
+            {
+                mTail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+                continue;
+            }
+
+            // the segment is used up, link a new one with the item in its first slot
+            auto* segment = allocateSegment();
+            segment->slots[0].value = std::move(item);
+            segment->slots[0].state.store(READY, std::memory_order_relaxed);
+            segment->enqueueIndex.store(1, std::memory_order_relaxed);
+
+            Segment* expected = nullptr;
+            if (tail->next.compare_exchange_strong(expected, segment, std::memory_order_acq_rel))
+            {
+                mTail.compare_exchange_strong(tail, segment, std::memory_order_acq_rel);
+                return true;
+            }
+
+            // another producer was first, take the item back
+            item = std::move(segment->slots[0].value);
+            recycle(segment);
+        }
+    }
+
+    // Publishes the pointer as hazardous, then checks it is still the current one.
+    static Segment* protect(const std::atomic<Segment*>& source, std::atomic<Segment*>& hazard)
+    {
+        auto* segment = source.load(std::memory_order_acquire);
+        while (true)
+        {
+            hazard.store(segment, std::memory_order_seq_cst);
+            auto* current = source.load(std::memory_order_seq_cst);
+            if (current == segment)
+            {
+                return segment;
+            }
+            segment = current;
+        }
+    }
+
+    Record& acquireRecord()
+    {
+        static thread_local const size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        for (size_t attempt = 0;; ++attempt)
+        {
+            auto& record = mRecords[(hint + attempt) % MAX_THREADS];
+            if (!record.active.load(std::memory_order_relaxed) && !record.active.exchange(true, std::memory_order_acquire))
+            {
+                return record;
+            }
+            if (attempt % MAX_THREADS == MAX_THREADS - 1)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Recycles the owner's retired segments which no thread has a hazard pointer to.
+    void retire(Record& owner, Segment* segment)
+    {
+        owner.retired.push_back(segment);
+        if (owner.retired.size() < RETIRE_THRESHOLD)
+        {
+            return;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<Segment*> hazards;
+        for (const auto& record : mRecords)
+        {
+            for (const auto& hazard : record.hazards)
+            {
+                if (auto* protectedSegment = hazard.load(std::memory_order_seq_cst))
+                {
+                    hazards.push_back(protectedSegment);
+                }
+            }
+        }
+
+        const auto stillUsed = [&](Segment* retired)
+        {
+            return std::find(hazards.begin(), hazards.end(), retired) != hazards.end();
+        };
+        const auto it = std::stable_partition(owner.retired.begin(), owner.retired.end(), stillUsed);
+        std::for_each(it, owner.retired.end(), [this](Segment* retired) { recycle(retired); });
+        owner.retired.erase(it, owner.retired.end());
+    }
+
+    Segment* allocateSegment()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mFreeSegmentsMutex};
+            if (!mFreeSegments.empty())
+            {
+                auto* segment = mFreeSegments.back();
+                mFreeSegments.pop_back();
+                return segment;
+            }
+        }
+        return new Segment;
+    }
+
+    // Resets the segment and keeps it for reuse, unless the free list is full.
+    void recycle(Segment* segment)
+    {
+        for (auto& slot : segment->slots)
+        {
+            slot.value = T{};
+            slot.state.store(EMPTY, std::memory_order_relaxed);
+        }
+        segment->enqueueIndex.store(0, std::memory_order_relaxed);
+        segment->dequeueIndex.store(0, std::memory_order_relaxed);
+        segment->next.store(nullptr, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock{mFreeSegmentsMutex};
+            if (mFreeSegments.size() < MAX_FREE_SEGMENTS)
+            {
+                mFreeSegments.push_back(segment);
+                return;
+            }
+        }
+        delete segment;
+    }
+
+private:
+    static constexpr size_t RETIRE_THRESHOLD = 4;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Segment*> mHead{nullptr};
+    alignas(CACHE_LINE_SIZE) std::atomic<Segment*> mTail{nullptr};
+    std::array<Record, MAX_THREADS> mRecords;
+    mutable std::mutex mFreeSegmentsMutex;
+    std::vector<Segment*> mFreeSegments;
+};
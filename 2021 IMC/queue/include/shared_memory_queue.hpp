@@ -0,0 +1,379 @@
+#pragma once
+
+#ifndef _WIN32
+
+#include <cache_line.hpp>
+#include <mpmc_queue.hpp>
+#include <spsc_queue.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Queues which keep all their state inside the object, with no pointers,
+// so they work at different addresses in different processes.
+// KIND tells the queues apart in the shared memory header.
+template <typename Queue>
+struct IsPositionIndependent : std::false_type
+{
+};
+
+template <typename T, size_t CAPACITY, typename WaitStrategy, typename Stats>
+struct IsPositionIndependent<SpscQueue<T, CAPACITY, WaitStrategy, Stats>> : std::true_type
+{
+    static constexpr uint32_t KIND = 1;
+};
+
+template <typename T, size_t CAPACITY, typename WaitStrategy, typename Stats>
+struct IsPositionIndependent<MpmcQueue<T, CAPACITY, WaitStrategy, Stats>> : std::true_type
+{
+    static constexpr uint32_t KIND = 2;
+};
+
+
+// SpscQueue or MpmcQueue placed into a POSIX shared memory object, so
+// producers and consumers can be different processes on the same host.
+//
+// One process creates the queue, others open it by name. The segment starts
+// with a versioned header describing the layout, an opener checks it against
+// its own Queue type. The header is marked ready only after the queue is
+// constructed, so an opener never sees a half-initialized queue, even if the
+// creator crashed. create() fails if the name is taken by a live queue, only a
+// stale segment (its creator process is gone) is replaced. The creator holds an
+// flock on the object during the initialization, the stale check takes it as well.
+// Elements must be trivially copyable, use ParkingWait (its futex is not
+// process-private) or a spinning strategy for blocking operations.
+template <typename Queue>
+class SharedMemoryQueue final
+{
+    using T = typename Queue::value_type;
+
+    static_assert(IsPositionIndependent<Queue>::value, "Only SpscQueue and MpmcQueue can live in shared memory");
+    static_assert(std::is_trivially_copyable_v<T>, "Elements must be trivially copyable to be shared between processes");
+
+public:
+    static constexpr uint64_t MAGIC = 0x4555455543434D49; // "IMCQUEUE"
+    static constexpr uint32_t LAYOUT_VERSION = 2;
+    static constexpr std::chrono::milliseconds DEFAULT_OPEN_TIMEOUT{1000};
+
+public:
+    // Creates the shared memory object, which is unlinked when the creator is destroyed.
+    static SharedMemoryQueue create(const std::string& name)
+    {
+        for (int attempt = 0; attempt < CREATE_ATTEMPTS; ++attempt)
+        {
+            const auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd == -1)
+            {
+                // a segment left by a crashed creator is removed, then the name is taken again
+                const auto error = errno;
+                if (error == EEXIST && removeStale(name))
+                {
+                    continue;
+                }
+                fail("create", name, error);
+            }
+
+            // The lock is held until the header is marked ready. A stale check locks the object
+            // too, so it either waits for the initialization or removes the object before it
+            // started, which is seen here as no links left.
+            struct stat info{};
+            if (flock(fd, LOCK_EX) == -1 || fstat(fd, &info) == -1)
+            {
+                const auto error = errno;
+                close(fd);
+                fail("lock", name, error);
+            }
+            if (info.st_nlink == 0)
+            {
+                close(fd);
+                continue;
+            }
+
+            if (ftruncate(fd, sizeof(Layout)) == -1)
+            {
+                const auto error = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                fail("resize", name, error);
+            }
+
+            SharedMemoryQueue result{name, fd, true};
+            auto* layout = new (result.mAddress) Layout;
+            layout->header.creator.store(getpid(), std::memory_order_relaxed);
+            layout->header.attached.store(1, std::memory_order_relaxed);
+            layout->header.ready.store(READY, std::memory_order_release);
+            result.mLayout = layout;
+            // the mapping keeps the file open, so the lock is released explicitly
+            flock(fd, LOCK_UN);
+            close(fd);
+            return result;
+        }
+
+        fail("create", name, EEXIST);
+    }
+
+    // Attaches to a queue created by another process, waits up to timeout until it is initialized.
+    static SharedMemoryQueue open(const std::string& name, std::chrono::milliseconds timeout = DEFAULT_OPEN_TIMEOUT)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        auto fd = shm_open(name.c_str(), O_RDWR, 0);
+        while (fd == -1 && errno == ENOENT && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+            fd = shm_open(name.c_str(), O_RDWR, 0);
+        }
+        if (fd == -1)
+        {
+            fail("open", name, errno);
+        }
+
+        struct stat info{};
+        while (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) < sizeof(Layout))
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                close(fd);
+                throw std::runtime_error("Shared memory queue '" + name + "' is too small for the queue type");
+            }
+            std::this_thread::yield();
+        }
+
+        SharedMemoryQueue result{name, fd, false};
+        auto* layout = std::launder(reinterpret_cast<Layout*>(result.mAddress));
+
+        while (layout->header.ready.load(std::memory_order_acquire) != READY)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                throw std::runtime_error("Shared memory queue '" + name + "' has not been initialized");
+            }
+            std::this_thread::yield();
+        }
+
+        if (!layout->header.matches())
+        {
+            throw std::runtime_error("Shared memory queue '" + name + "' has a different layout version or queue type");
+        }
+
+        layout->header.attached.fetch_add(1, std::memory_order_relaxed);
+        result.mLayout = layout;
+        return result;
+    }
+
+    SharedMemoryQueue(SharedMemoryQueue&& another) noexcept
+        : mName{std::move(another.mName)}
+        , mAddress{std::exchange(another.mAddress, nullptr)}
+        , mLayout{std::exchange(another.mLayout, nullptr)}
+        , mOwner{std::exchange(another.mOwner, false)}
+    {
+    }
+
+    SharedMemoryQueue& operator=(SharedMemoryQueue&& another) noexcept
+    {
+        if (this != &another)
+        {
+            detach();
+            mName = std::move(another.mName);
+            mAddress = std::exchange(another.mAddress, nullptr);
+            mLayout = std::exchange(another.mLayout, nullptr);
+            mOwner = std::exchange(another.mOwner, false);
+        }
+        return *this;
+    }
+
+    SharedMemoryQueue(const SharedMemoryQueue&) = delete;
+    SharedMemoryQueue& operator=(const SharedMemoryQueue&) = delete;
+
+    ~SharedMemoryQueue()
+    {
+        detach();
+    }
+
+    Queue& queue()
+    {
+        return mLayout->queue;
+    }
+
+    Queue* operator->()
+    {
+        return &mLayout->queue;
+    }
+
+    const std::string& name() const
+    {
+        return mName;
+    }
+
+    // Number of attached SharedMemoryQueue objects, a crashed process is never detached.
+    uint32_t attached() const
+    {
+        return mLayout->header.attached.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t READY = 1;
+    static constexpr int CREATE_ATTEMPTS = 16;
+
+    struct Header
+    {
+        uint64_t magic = MAGIC;
+        uint32_t version = LAYOUT_VERSION;
+        uint32_t kind = IsPositionIndependent<Queue>::KIND;
+        uint32_t elementSize = sizeof(T);
+        uint64_t capacity = Queue::capacity();
+        uint64_t queueSize = sizeof(Queue);
+        std::atomic<uint32_t> ready{0};
+        std::atomic<uint32_t> attached{0};
+        // process id of the creator, 0 until it is known
+        std::atomic<int32_t> creator{0};
+
+        bool matches() const
+        {
+            return magic == MAGIC
+                && version == LAYOUT_VERSION
+                && kind == IsPositionIndependent<Queue>::KIND
+                && elementSize == sizeof(T)
+                && capacity == Queue::capacity()
+                && queueSize == sizeof(Queue);
+        }
+    };
+
+    struct Layout
+    {
+        Header header;
+        alignas(CACHE_LINE_SIZE) Queue queue;
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Header atomics must be lock-free to work across processes");
+    static_assert(std::atomic<int32_t>::is_always_lock_free, "Header atomics must be lock-free to work across processes");
+    static_assert(sizeof(pid_t) <= sizeof(int32_t), "Process id must fit into the header");
+
+    // Removes the object under the name if it is stale, returns true if the name may be free now.
+    // Only the header of an existing object is read, it may have been made by a queue of another type.
+    // The object is locked like in create(), so a live creator which has not finished the
+    // initialization yet is waited for, and two checkers never remove each other's objects.
+    static bool removeStale(const std::string& name)
+    {
+        const auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd == -1)
+        {
+            // removed in between, the name is free
+            return errno == ENOENT;
+        }
+
+        struct stat info{};
+        if (flock(fd, LOCK_EX) == -1 || fstat(fd, &info) == -1)
+        {
+            close(fd);
+            return false;
+        }
+        if (info.st_nlink == 0)
+        {
+            // removed by another checker while this one waited for the lock
+            close(fd);
+            return true;
+        }
+
+        // With the lock taken an unfinished header means that its creator is gone. Right after
+        // the exclusive open, before the creator took the lock, the object may look the same,
+        // then the creator sees it removed and tries again.
+        auto stale = static_cast<size_t>(info.st_size) < sizeof(Header);
+        if (!stale)
+        {
+            auto* address = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                close(fd);
+                return false;
+            }
+
+            const auto* header = std::launder(reinterpret_cast<const Header*>(address));
+            const auto ready = header->ready.load(std::memory_order_acquire);
+            const auto creator = static_cast<pid_t>(header->creator.load(std::memory_order_relaxed));
+            munmap(address, sizeof(Header));
+
+            stale = ready != READY || creator == 0 || (kill(creator, 0) == -1 && errno == ESRCH);
+        }
+
+        // the name still refers to the locked object, nobody else removes it while the lock is held
+        if (stale)
+        {
+            shm_unlink(name.c_str());
+        }
+        close(fd);
+        return stale;
+    }
+
+    [[noreturn]] static void fail(const std::string& action, const std::string& name, int error)
+    {
+        throw std::runtime_error("Failed to " + action + " shared memory '" + name + "': " + std::strerror(error));
+    }
+
+    // Maps the whole object, the descriptor of an opener is not needed after that,
+    // the creator keeps its one locked until the queue is initialized.
+    SharedMemoryQueue(const std::string& name, int fd, bool owner)
+        : mName{name}
+        , mOwner{owner}
+    {
+        auto* address = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const auto error = errno;
+        if (!owner || address == MAP_FAILED)
+        {
+            close(fd);
+        }
+        if (address == MAP_FAILED)
+        {
+            if (owner)
+            {
+                shm_unlink(name.c_str());
+            }
+            fail("map", name, error);
+        }
+        mAddress = address;
+    }
+
+    void detach()
+    {
+        if (mLayout)
+        {
+            mLayout->header.attached.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (mAddress)
+        {
+            munmap(mAddress, sizeof(Layout));
+        }
+        if (mOwner)
+        {
+            shm_unlink(mName.c_str());
+        }
+
+        mAddress = nullptr;
+        mLayout = nullptr;
+        mOwner = false;
+    }
+
+private:
+    std::string mName;
+    void* mAddress = nullptr;
+    Layout* mLayout = nullptr;
+    bool mOwner = false;
+};
+
+#endif
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cache_line.hpp>
+#include <queue_stats.hpp>
+#include <wait_strategy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+//
+// Head (next index to read) and tail (next index to write) grow monotonically
+// and are masked into the ring. Each side owns a cache line with its own index
+// and a cached copy of the other side's index, so the shared line is only read
+// when the cached value says the queue looks full (producer) or empty (consumer).
+// Blocking push and pop wait according to WaitStrategy (see wait_strategy.hpp),
+// operations are counted by Stats (see queue_stats.hpp).
+template <typename T, size_t CAPACITY, typename WaitStrategy = BusySpinWait, typename Stats = NoStats>
+class SpscQueue final
+{
+    static_assert(isPowerOfTwo(CAPACITY), "Capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T>, "Elements must be default constructible");
+
+public:
+    using value_type = T;
+
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return CAPACITY;
+    }
+
+    // Producer side.
+    bool try_push(const T& item)
+    {
+        return emplace(item);
+    }
+
+    bool try_push(T&& item)
+    {
+        return emplace(std::move(item));
+    }
+
+    // Waits for a free slot.
+    void push(const T& item)
+    {
+        waitAndCount(mStats, QueueSide::PRODUCER, mNotFull, [&]{ return try_push(item); });
+    }
+
+    void push(T&& item)
+    {
+        waitAndCount(mStats, QueueSide::PRODUCER, mNotFull, [&]{ return try_push(std::move(item)); });
+    }
+
+    // Pushes up to count items starting from first, returns the number of pushed items.
+    template <typename InputIt>
+    size_t try_push_n(InputIt first, size_t count)
+    {
+        const auto tail = mProducer.index.load(std::memory_order_relaxed);
+        count = std::min(count, freeSlots(tail, count));
+
+        for (size_t i = 0; i < count; ++i, ++first)
+        {
+            mBuffer[(tail + i) & MASK] = *first;
+        }
+
+        if (count == 0)
+        {
+            mStats.failed(QueueSide::PRODUCER);
+            return 0;
+        }
+
+        mProducer.index.store(tail + count, std::memory_order_release);
+        pushed(tail, count);
+        mNotEmpty.notify();
+        return count;
+    }
+
+    // Pushes items from [first, last) while there are free slots, returns the number of pushed items.
+    template <typename ForwardIt>
+    size_t try_push_bulk(ForwardIt first, ForwardIt last)
+    {
+        return try_push_n(first, static_cast<size_t>(std::distance(first, last)));
+    }
+
+    // Consumer side.
+    bool try_pop(T& result)
+    {
+        const auto head = mConsumer.index.load(std::memory_order_relaxed);
+        if (availableItems(head, 1) == 0)
+        {
+            mStats.failed(QueueSide::CONSUMER);
+            return false;
+        }
+
+        result = std::move(mBuffer[head & MASK]);
+        mConsumer.index.store(head + 1, std::memory_order_release);
+        mStats.completed(QueueSide::CONSUMER, 1);
+        mNotFull.notify();
+        return true;
+    }
+
+    // Waits for an item.
+    void pop(T& result)
+    {
+        waitAndCount(mStats, QueueSide::CONSUMER, mNotEmpty, [&]{ return try_pop(result); });
+    }
+
+    // Pops up to count items into out, returns the number of popped items.
+    template <typename OutputIt>
+    size_t try_pop_n(OutputIt out, size_t count)
+    {
+        const auto head = mConsumer.index.load(std::memory_order_relaxed);
+        count = std::min(count, availableItems(head, count));
+
+        for (size_t i = 0; i < count; ++i, ++out)
+        {
+            *out = std::move(mBuffer[(head + i) & MASK]);
+        }
+
+        if (count == 0)
+        {
+            mStats.failed(QueueSide::CONSUMER);
+            return 0;
+        }
+
+        mConsumer.index.store(head + count, std::memory_order_release);
+        mStats.completed(QueueSide::CONSUMER, count);
+        mNotFull.notify();
+        return count;
+    }
+
+    // Calls callback(T&) for up to max available items in place, then frees their
+    // slots at once. Returns the number of processed items.
+    // The callback must not throw and must not pop from this queue.
+    template <typename Callback>
+    size_t drain(Callback&& callback, size_t max = std::numeric_limits<size_t>::max())
+    {
+        const auto head = mConsumer.index.load(std::memory_order_relaxed);
+        const auto count = std::min(max, availableItems(head, max));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            callback(mBuffer[(head + i) & MASK]);
+        }
+
+        if (count == 0)
+        {
+            mStats.failed(QueueSide::CONSUMER);
+            return 0;
+        }
+
+        mConsumer.index.store(head + count, std::memory_order_release);
+        mStats.completed(QueueSide::CONSUMER, count);
+        mNotFull.notify();
+        return count;
+    }
+
+    // Approximate if called concurrently with push or pop.
+    size_t size() const
+    {
+        const auto head = mConsumer.index.load(std::memory_order_acquire);
+        const auto tail = mProducer.index.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    const Stats& stats() const
+    {
+        return mStats;
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    // Index owned by one side and the last seen index of the other side.
+    struct alignas(CACHE_LINE_SIZE) Side
+    {
+        std::atomic<size_t> index{0};
+        size_t cachedRemoteIndex = 0;
+    };
+
+    template <typename U>
+    bool emplace(U&& item)
+    {
+        const auto tail = mProducer.index.load(std::memory_order_relaxed);
+        if (freeSlots(tail, 1) == 0)
+        {
+            mStats.failed(QueueSide::PRODUCER);
+            return false;
+        }
+
+        mBuffer[tail & MASK] = std::forward<U>(item);
+        mProducer.index.store(tail + 1, std::memory_order_release);
+        pushed(tail, 1);
+        mNotEmpty.notify();
+        return true;
+    }
+
+    // Counts pushed items, occupancy is taken against the cached consumer's index,
+    // so it is an upper bound which costs no access to the consumer's cache line.
+    void pushed(size_t tail, size_t count)
+    {
+        mStats.completed(QueueSide::PRODUCER, count);
+        if (mStats.sampleOccupancy(tail, count))
+        {
+            mStats.occupancy(tail + count - mProducer.cachedRemoteIndex);
+        }
+    }
+
+    // Number of free slots, the consumer's index is reloaded only if the cached one gives less than wanted.
+    size_t freeSlots(size_t tail, size_t wanted)
+    {
+        auto free = CAPACITY - (tail - mProducer.cachedRemoteIndex);
+        if (free < wanted)
+        {
+            mProducer.cachedRemoteIndex = mConsumer.index.load(std::memory_order_acquire);
+            free = CAPACITY - (tail - mProducer.cachedRemoteIndex);
+        }
+        return free;
+    }
+
+    // Number of available items, the producer's index is reloaded only if the cached one gives less than wanted.
+    size_t availableItems(size_t head, size_t wanted)
+    {
+        auto available = mConsumer.cachedRemoteIndex - head;
+        if (available < wanted)
+        {
+            mConsumer.cachedRemoteIndex = mProducer.index.load(std::memory_order_acquire);
+            available = mConsumer.cachedRemoteIndex - head;
+        }
+        return available;
+    }
+
+private:
+    Side mProducer;
+    Side mConsumer;
+    WaitStrategy mNotEmpty;
+    WaitStrategy mNotFull;
+    Stats mStats;
+    alignas(CACHE_LINE_SIZE) std::array<T, CAPACITY> mBuffer{};
+};
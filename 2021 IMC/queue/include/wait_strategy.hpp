@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cache_line.hpp>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Wait strategies for blocking queue operations.
+//
+// A strategy is used in pairs by a queue: consumers wait on one until an item
+// may be available, producers on another until a slot may be free. Both sides
+// call notify() after every successful operation, so it has to be cheap when
+// nobody waits. The interface is:
+//   template <typename Predicate> void wait(Predicate&& ready); // returns once ready() is true
+//   void notify();
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+
+// Spins on the CPU, the lowest latency at the cost of a fully busy core.
+struct BusySpinWait
+{
+    template <typename Predicate>
+    void wait(Predicate&& ready)
+    {
+        while (!ready())
+        {
+            cpuRelax();
+        }
+    }
+
+    void notify()
+    {
+    }
+};
+
+
+// Spins for a while, then yields the CPU to other threads between checks.
+struct YieldingWait
+{
+    static constexpr unsigned SPIN_LIMIT = 100;
+
+    template <typename Predicate>
+    void wait(Predicate&& ready)
+    {
+        for (unsigned i = 0; i < SPIN_LIMIT; ++i)
+        {
+            if (ready())
+            {
+                return;
+            }
+            cpuRelax();
+        }
+
+        while (!ready())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void notify()
+    {
+    }
+};
+
+
+// Spins for a while, then parks the thread in the kernel (a futex on Linux).
+// Waiters register themselves, so notify() is a fence and a load unless
+// somebody is parked. The futex is not process-private, so the strategy works
+// inside shared memory as well.
+class alignas(CACHE_LINE_SIZE) ParkingWait
+{
+public:
+    static constexpr unsigned SPIN_LIMIT = 1000;
+
+    template <typename Predicate>
+    void wait(Predicate&& ready)
+    {
+        for (unsigned i = 0; i < SPIN_LIMIT; ++i)
+        {
+            if (ready())
+            {
+                return;
+            }
+            cpuRelax();
+        }
+
+        while (true)
+        {
+            const auto epoch = mEpoch.load(std::memory_order_acquire);
+            mWaiters.fetch_add(1, std::memory_order_seq_cst);
+            // pairs with the fence in notify(): either the notifier sees the registration,
+            // or the check below sees its published state
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // the condition may have changed before the registration was visible to notifiers
+            if (ready())
+            {
+                mWaiters.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+
+            park(epoch);
+            mWaiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (ready())
+            {
+                return;
+            }
+        }
+    }
+
+    void notify()
+    {
+        // orders the caller's publishing store before the waiters check,
+        // pairs with the registration in wait()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mWaiters.load(std::memory_order_relaxed) != 0)
+        {
+            wake();
+        }
+    }
+
+private:
+#ifdef __linux__
+    // Sleeps unless the epoch has already changed, may return spuriously.
+    void park(uint32_t epoch)
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mEpoch), FUTEX_WAIT, epoch, nullptr, nullptr, 0);
+    }
+
+    void wake()
+    {
+        mEpoch.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&mEpoch), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+#else
+    void park(uint32_t epoch)
+    {
+        std::unique_lock<std::mutex> lock{mMutex};
+        mCondition.wait(lock, [&]{ return mEpoch.load(std::memory_order_acquire) != epoch; });
+    }
+
+    void wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mMutex};
+            mEpoch.fetch_add(1, std::memory_order_release);
+        }
+        mCondition.notify_all();
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+#endif
+
+private:
+    std::atomic<uint32_t> mEpoch{0};
+    std::atomic<uint32_t> mWaiters{0};
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32-bit integer");
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cache_line.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Bounded work-stealing deque (Chase-Lev): the owner thread pushes and pops at
+// the bottom, any other thread steals from the top.
+//
+// Unlike the classic algorithm, which copies an element before claiming it,
+// an element is claimed first (by moving top or bottom) and only then moved
+// out, so elements do not have to be trivially copyable. A slot is reused by
+// the owner only after whoever claimed it cleared its full flag; until then
+// the deque reports itself full.
+template <typename T, size_t CAPACITY>
+class WorkStealingDeque final
+{
+    static_assert(isPowerOfTwo(CAPACITY), "Capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T>, "Elements must be default constructible");
+
+public:
+    WorkStealingDeque() = default;
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    static constexpr size_t capacity()
+    {
+        return CAPACITY;
+    }
+
+    // Owner side, the item is moved from only if it is pushed.
+    bool try_push(T&& item)
+    {
+        const auto bottom = mBottom.load(std::memory_order_relaxed);
+        const auto top = mTop.load(std::memory_order_acquire);
+        auto& slot = mSlots[bottom & MASK];
+
+        if (bottom - top >= static_cast<int64_t>(CAPACITY) || slot.full.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        slot.value = std::move(item);
+        slot.full.store(true, std::memory_order_relaxed);
+        mBottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner side, takes the most recently pushed item.
+    bool try_pop(T& result)
+    {
+        const auto bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = mTop.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (top == bottom)
+        {
+            // the last item, race with thieves for it
+            const auto won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won)
+            {
+                return false;
+            }
+        }
+
+        take(bottom, result);
+        return true;
+    }
+
+    // Any thread, takes the least recently pushed item.
+    // Fails if the deque is empty or another thread took the item first.
+    bool try_steal(T& result)
+    {
+        auto top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = mBottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return false;
+        }
+
+        if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        take(top, result);
+        return true;
+    }
+
+    // Approximate if called concurrently with other operations.
+    size_t size() const
+    {
+        const auto bottom = mBottom.load(std::memory_order_acquire);
+        const auto top = mTop.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+
+    struct Slot
+    {
+        std::atomic<bool> full{false};
+        T value;
+    };
+
+    // Moves out an item at the already claimed position and frees the slot.
+    void take(int64_t position, T& result)
+    {
+        auto& slot = mSlots[position & MASK];
+        result = std::move(slot.value);
+        slot.value = T{};
+        slot.full.store(false, std::memory_order_release);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> mTop{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> mBottom{0};
+    alignas(CACHE_LINE_SIZE) std::array<Slot, CAPACITY> mSlots;
+};
@@ -0,0 +1,162 @@
+#include "stress_checker.hpp"
+#include "../bench/legacy_queues.hpp"
+
+#include <mpmc_queue.hpp>
+#include <queue_stats.hpp>
+#include <segmented_queue.hpp>
+#include <spsc_queue.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::string queue = "all";
+        StressConfig config;
+        unsigned rounds = 3;
+    };
+
+    // A named queue type, singleProducer/singleConsumer limit the number of threads.
+    struct Target
+    {
+        std::string name;
+        bool legacy;
+        bool singleProducer;
+        bool singleConsumer;
+        std::function<StressReport(const StressConfig&)> run;
+    };
+
+    template <typename Queue>
+    Target target(const std::string& name, bool legacy, bool singleProducer, bool singleConsumer)
+    {
+        return Target{name, legacy, singleProducer, singleConsumer, [](const StressConfig& config)
+        {
+            auto queue = std::make_unique<Queue>();
+            return runStress(*queue, config);
+        }};
+    }
+
+    const std::vector<Target>& targets()
+    {
+        static const std::vector<Target> result = {
+            target<SpscQueue<uint64_t, 1024>>("spsc", false, true, true),
+            target<MpmcQueue<uint64_t, 1024>>("mpmc", false, false, false),
+            target<MpmcQueue<uint64_t, 16, YieldingWait, QueueStats>>("mpmc-small", false, false, false),
+            target<SegmentedQueue<uint64_t, 32>>("segmented", false, false, false),
+            target<clean::ConcurrentQueue<uint64_t, 1024>>("clean", true, false, false),
+            target<fast::ConcurrentQueue<uint64_t, 1024>>("fast", true, false, true),
+        };
+        return result;
+    }
+
+    Options parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string name = argv[i];
+            const std::string value = argv[i + 1];
+
+            if (name == "--queue")
+            {
+                options.queue = value;
+            }
+            else if (name == "--producers")
+            {
+                options.config.producers = static_cast<unsigned>(std::stoul(value));
+            }
+            else if (name == "--consumers")
+            {
+                options.config.consumers = static_cast<unsigned>(std::stoul(value));
+            }
+            else if (name == "--items")
+            {
+                options.config.itemsPerProducer = std::stoull(value);
+            }
+            else if (name == "--seed")
+            {
+                options.config.seed = std::stoull(value);
+            }
+            else if (name == "--rounds")
+            {
+                options.rounds = static_cast<unsigned>(std::stoul(value));
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option " + name);
+            }
+        }
+        if (argc % 2 == 0)
+        {
+            throw std::runtime_error("No value for option " + std::string{argv[argc - 1]});
+        }
+        if (options.config.producers == 0 || options.config.consumers == 0)
+        {
+            throw std::runtime_error("There must be at least one producer and one consumer");
+        }
+        return options;
+    }
+
+    bool check(const Target& target, const Options& options)
+    {
+        auto config = options.config;
+        config.producers = target.singleProducer ? 1 : config.producers;
+        config.consumers = target.singleConsumer ? 1 : config.consumers;
+
+        bool ok = true;
+        for (unsigned round = 0; round < options.rounds; ++round, ++config.seed)
+        {
+            const auto report = target.run(config);
+            ok = ok && report.ok();
+
+            std::cout << target.name << " " << config.producers << "p" << config.consumers << "c"
+                      << " seed " << config.seed << ": "
+                      << (report.ok() ? "OK" : "FAILED")
+                      << " (pushed " << report.pushed << ", popped " << report.popped
+                      << ", lost " << report.lost << ", duplicated " << report.duplicated
+                      << ", reordered " << report.reordered << ", corrupted " << report.corrupted << ")" << std::endl;
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto options = parseOptions(argc, argv);
+
+        // the reviewed queues are known to be broken, they are checked only on request
+        bool found = false;
+        bool ok = true;
+        for (const auto& target : targets())
+        {
+            if (options.queue == target.name || (options.queue == "all" && !target.legacy))
+            {
+                found = true;
+                ok = check(target, options) && ok;
+            }
+        }
+
+        if (!found)
+        {
+            throw std::runtime_error("Unknown queue " + options.queue);
+        }
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage:\n"
+                  << "\t" << argv[0] << " [--queue all|spsc|mpmc|mpmc-small|segmented|clean|fast] [--producers N] [--consumers N]"
+                  << " [--items N] [--seed N] [--rounds N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
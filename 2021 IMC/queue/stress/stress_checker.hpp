@@ -0,0 +1,243 @@
+#pragma once
+
+#include <wait_strategy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Runs producers and consumers with random schedules against a queue of
+// uint64_t and checks the history: every item is (producer << 40) | sequence,
+// so a consumer must see items of each producer in increasing order, and every
+// pushed item must be popped exactly once.
+//
+// Threads randomly yield, spin or (if the queue has them) use bulk operations
+// of random sizes. Consumers give up when producers are done and nothing has
+// been popped for stallTimeout, so lost items are reported instead of hanging.
+struct StressConfig
+{
+    unsigned producers = 4;
+    unsigned consumers = 4;
+    uint64_t itemsPerProducer = 100000;
+    uint64_t seed = 1;
+    std::chrono::milliseconds stallTimeout{2000};
+};
+
+struct StressReport
+{
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+    uint64_t lost = 0;
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;
+    uint64_t corrupted = 0;
+
+    bool ok() const
+    {
+        return lost == 0 && duplicated == 0 && reordered == 0 && corrupted == 0 && popped == pushed;
+    }
+};
+
+namespace stress
+{
+    constexpr unsigned SEQUENCE_BITS = 40;
+    constexpr uint64_t SEQUENCE_MASK = (uint64_t{1} << SEQUENCE_BITS) - 1;
+    constexpr size_t MAX_BATCH = 16;
+
+    template <typename Queue, typename = void>
+    struct HasBulk : std::false_type
+    {
+    };
+
+    template <typename Queue>
+    struct HasBulk<Queue, std::void_t<decltype(std::declval<Queue&>().drain(std::declval<void (*)(uint64_t&)>(), size_t{}))>>
+        : std::true_type
+    {
+    };
+
+    // Yields or spins now and then to shuffle the interleaving of threads.
+    inline void randomPause(std::mt19937_64& random)
+    {
+        const auto action = random() % 16;
+        if (action == 0)
+        {
+            std::this_thread::yield();
+        }
+        else if (action == 1)
+        {
+            for (auto spins = random() % 200; spins > 0; --spins)
+            {
+                cpuRelax();
+            }
+        }
+    }
+
+    template <typename Queue>
+    void produce(Queue& queue, const StressConfig& config, uint64_t producer, std::atomic<uint64_t>& pushed)
+    {
+        std::mt19937_64 random{config.seed * 1000003 + producer};
+        std::vector<uint64_t> batch(MAX_BATCH);
+
+        for (uint64_t sequence = 0; sequence < config.itemsPerProducer;)
+        {
+            randomPause(random);
+
+            size_t count = 0;
+            if constexpr (HasBulk<Queue>::value)
+            {
+                if (random() % 2 == 0)
+                {
+                    const auto size = std::min<uint64_t>(1 + random() % MAX_BATCH, config.itemsPerProducer - sequence);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        batch[i] = (producer << SEQUENCE_BITS) | (sequence + i);
+                    }
+                    count = queue.try_push_bulk(batch.begin(), batch.begin() + static_cast<ptrdiff_t>(size));
+                }
+            }
+            if (count == 0 && queue.try_push((producer << SEQUENCE_BITS) | sequence))
+            {
+                count = 1;
+            }
+
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+            sequence += count;
+            pushed.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename Queue>
+StressReport runStress(Queue& queue, const StressConfig& config)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto expected = config.producers * config.itemsPerProducer;
+
+    // times every item has been popped
+    std::vector<std::unique_ptr<std::atomic<uint8_t>[]>> seen;
+    for (unsigned p = 0; p < config.producers; ++p)
+    {
+        seen.push_back(std::make_unique<std::atomic<uint8_t>[]>(config.itemsPerProducer));
+    }
+
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> popped{0};
+    std::atomic<uint64_t> reordered{0};
+    std::atomic<uint64_t> corrupted{0};
+    std::atomic<unsigned> runningProducers{config.producers};
+
+    // checks the order of producers' items seen by one consumer
+    const auto consume = [&](uint64_t item, std::vector<int64_t>& last)
+    {
+        const auto producer = item >> stress::SEQUENCE_BITS;
+        const auto sequence = static_cast<int64_t>(item & stress::SEQUENCE_MASK);
+        if (producer >= config.producers || sequence >= static_cast<int64_t>(config.itemsPerProducer))
+        {
+            // nobody pushed such an item, e.g. a torn or uninitialized read
+            corrupted.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (sequence <= last[producer])
+        {
+            reordered.fetch_add(1, std::memory_order_relaxed);
+        }
+        last[producer] = sequence;
+        seen[producer][sequence].fetch_add(1, std::memory_order_relaxed);
+        popped.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < config.producers; ++p)
+    {
+        threads.emplace_back([&, p]
+        {
+            stress::produce(queue, config, p, pushed);
+            runningProducers.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    for (unsigned c = 0; c < config.consumers; ++c)
+    {
+        threads.emplace_back([&, c]
+        {
+            std::mt19937_64 random{config.seed * 1000003 + config.producers + c};
+            std::vector<int64_t> last(config.producers, -1);
+            auto lastSuccess = Clock::now();
+
+            while (popped.load(std::memory_order_relaxed) < expected)
+            {
+                stress::randomPause(random);
+
+                size_t count = 0;
+                if constexpr (stress::HasBulk<Queue>::value)
+                {
+                    if (random() % 2 == 0)
+                    {
+                        count = queue.drain([&](uint64_t& item) { consume(item, last); }, 1 + random() % stress::MAX_BATCH);
+                    }
+                }
+
+                uint64_t item = 0;
+                if (count == 0 && queue.try_pop(item))
+                {
+                    consume(item, last);
+                    count = 1;
+                }
+
+                if (count != 0)
+                {
+                    lastSuccess = Clock::now();
+                }
+                else if (runningProducers.load(std::memory_order_acquire) == 0 && Clock::now() - lastSuccess > config.stallTimeout)
+                {
+                    break;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // leftovers, e.g. duplicates popped after the expected number was reached
+    std::vector<int64_t> last(config.producers, -1);
+    uint64_t item = 0;
+    while (queue.try_pop(item))
+    {
+        consume(item, last);
+    }
+
+    StressReport report;
+    report.pushed = pushed.load();
+    report.popped = popped.load();
+    report.reordered = reordered.load();
+    report.corrupted = corrupted.load();
+    for (unsigned p = 0; p < config.producers; ++p)
+    {
+        for (uint64_t i = 0; i < config.itemsPerProducer; ++i)
+        {
+            const auto times = seen[p][i].load();
+            report.lost += times == 0 ? 1 : 0;
+            report.duplicated += times > 1 ? times - 1 : 0;
+        }
+    }
+    return report;
+}
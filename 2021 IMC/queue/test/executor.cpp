@@ -0,0 +1,119 @@
+#include <executor.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Executor :: Runs all tasks", "[executor]")
+{
+    Executor executor{4};
+    CHECK(executor.numberOfThreads() == 4);
+
+    std::atomic<uint64_t> sum{0};
+    for (uint64_t i = 1; i <= 10000; ++i)
+    {
+        executor.submit([&sum, i]{ sum += i; });
+    }
+    executor.wait();
+
+    CHECK(sum == 10000 * 10001 / 2);
+}
+
+TEST_CASE("Executor :: Tasks run on worker threads", "[executor]")
+{
+    Executor executor{2};
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    for (int i = 0; i < 100; ++i)
+    {
+        executor.submit([&]
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    executor.wait();
+
+    CHECK_FALSE(threads.empty());
+    CHECK(threads.size() <= 2);
+    CHECK(threads.count(std::this_thread::get_id()) == 0);
+}
+
+TEST_CASE("Executor :: Fan-out from tasks", "[executor]")
+{
+    Executor executor{4};
+
+    // a binary tree of tasks, every leaf adds one
+    constexpr unsigned DEPTH = 14;
+    std::atomic<uint64_t> leaves{0};
+    std::function<void(unsigned)> spawn = [&](unsigned depth)
+    {
+        if (depth == DEPTH)
+        {
+            ++leaves;
+            return;
+        }
+        executor.submit([&spawn, depth]{ spawn(depth + 1); });
+        executor.submit([&spawn, depth]{ spawn(depth + 1); });
+    };
+
+    executor.submit([&spawn]{ spawn(0); });
+    executor.wait();
+
+    CHECK(leaves == (1u << DEPTH));
+}
+
+TEST_CASE("Executor :: Many submitting threads", "[executor]")
+{
+    constexpr uint64_t SUBMITTERS = 4;
+    constexpr uint64_t TASKS = 5000;
+
+    Executor executor{2};
+    std::atomic<uint64_t> executed{0};
+
+    std::vector<std::thread> submitters;
+    for (uint64_t i = 0; i < SUBMITTERS; ++i)
+    {
+        submitters.emplace_back([&]
+        {
+            for (uint64_t j = 0; j < TASKS; ++j)
+            {
+                executor.submit([&executed]{ ++executed; });
+            }
+        });
+    }
+    for (auto& submitter : submitters)
+    {
+        submitter.join();
+    }
+    executor.wait();
+
+    CHECK(executed == SUBMITTERS * TASKS);
+}
+
+TEST_CASE("Executor :: Destructor runs pending tasks", "[executor]")
+{
+    std::atomic<uint64_t> executed{0};
+
+    {
+        Executor executor{1};
+        for (int i = 0; i < 1000; ++i)
+        {
+            // a capture bigger than a task is boxed explicitly
+            auto payload = std::make_unique<std::array<char, 128>>();
+            (*payload)[0] = 1;
+            executor.submit([&executed, payload = std::move(payload)]{ executed += static_cast<uint64_t>((*payload)[0]); });
+        }
+    }
+
+    CHECK(executed == 1000);
+}
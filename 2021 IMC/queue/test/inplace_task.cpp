@@ -0,0 +1,105 @@
+#include <inplace_task.hpp>
+#include <spsc_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+TEST_CASE("InplaceTask :: Empty task", "[inplace-task]")
+{
+    InplaceTask<32> task;
+    CHECK_FALSE(task);
+}
+
+TEST_CASE("InplaceTask :: Call", "[inplace-task]")
+{
+    int calls = 0;
+    InplaceTask<32> task{[&calls]{ ++calls; }};
+    REQUIRE(task);
+
+    task();
+    task();
+    CHECK(calls == 2);
+}
+
+TEST_CASE("InplaceTask :: Trivial captures are copied on move", "[inplace-task]")
+{
+    std::array<int, 8> values{1, 2, 3, 4, 5, 6, 7, 8};
+    int result = 0;
+
+    InplaceTask<48> task{[values, &result]{ result = values[7]; }};
+    InplaceTask<48> another{std::move(task)};
+    CHECK_FALSE(task);
+
+    another();
+    CHECK(result == 8);
+}
+
+TEST_CASE("InplaceTask :: Move-only captures are moved and destroyed", "[inplace-task]")
+{
+    auto counter = std::make_shared<int>(0);
+
+    InplaceTask<16> task{[pointer = std::make_unique<std::shared_ptr<int>>(counter)]{ ++**pointer; }};
+    CHECK(counter.use_count() == 2);
+
+    InplaceTask<16> another;
+    another = std::move(task);
+    CHECK_FALSE(task);
+    another();
+    CHECK(*counter == 1);
+
+    another = InplaceTask<16>{};
+    CHECK(counter.use_count() == 1);
+}
+
+TEST_CASE("InplaceTask :: Fits", "[inplace-task]")
+{
+    using Small = std::array<char, 16>;
+    using Big = std::array<char, 17>;
+
+    CHECK(InplaceTask<16>::fits<Small>());
+    CHECK_FALSE(InplaceTask<16>::fits<Big>());
+    CHECK_FALSE(std::is_copy_constructible_v<InplaceTask<16>>);
+}
+
+TEST_CASE("InplaceTask :: Tasks passed through a queue", "[inplace-task]")
+{
+    constexpr uint64_t TASKS = 10000;
+    using Task = InplaceTask<24>;
+
+    auto queue = std::make_unique<SpscQueue<Task, 256>>();
+    uint64_t sum = 0;
+
+    std::thread consumer([&]
+    {
+        Task task;
+        for (uint64_t i = 0; i < TASKS;)
+        {
+            if (queue->try_pop(task))
+            {
+                task();
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (uint64_t i = 1; i <= TASKS; ++i)
+    {
+        Task task{[&sum, i]{ sum += i; }};
+        while (!queue->try_push(std::move(task)))
+        {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    CHECK(sum == TASKS * (TASKS + 1) / 2);
+}
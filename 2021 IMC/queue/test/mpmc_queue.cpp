@@ -0,0 +1,195 @@
+#include <mpmc_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpmcQueue :: Empty queue", "[mpmc-queue]")
+{
+    MpmcQueue<int, 4> queue;
+
+    int value = 0;
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.try_pop(value));
+}
+
+TEST_CASE("MpmcQueue :: Full queue", "[mpmc-queue]")
+{
+    MpmcQueue<int, 4> queue;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(queue.try_push(i));
+    }
+    CHECK_FALSE(queue.try_push(4));
+    CHECK(queue.size() == 4);
+
+    int value = 0;
+    CHECK(queue.try_pop(value));
+    CHECK(value == 0);
+    CHECK(queue.try_push(4));
+    CHECK_FALSE(queue.try_push(5));
+}
+
+TEST_CASE("MpmcQueue :: FIFO order with wraparound", "[mpmc-queue]")
+{
+    MpmcQueue<std::string, 8> queue;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            REQUIRE(queue.try_push(std::to_string(round * 5 + i)));
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            std::string value;
+            REQUIRE(queue.try_pop(value));
+            CHECK(value == std::to_string(round * 5 + i));
+        }
+    }
+    CHECK(queue.empty());
+}
+
+TEST_CASE("MpmcQueue :: Bulk push and drain", "[mpmc-queue]")
+{
+    MpmcQueue<std::string, 8> queue;
+    const std::vector<std::string> input = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+
+    CHECK(queue.try_push_bulk(input.begin(), input.begin()) == 0);
+    CHECK(queue.try_push_bulk(input.begin(), input.begin() + 5) == 5);
+    CHECK(queue.try_push_bulk(input.begin() + 5, input.end()) == 3);
+    CHECK(queue.try_push_bulk(input.begin(), input.end()) == 0);
+
+    std::vector<std::string> output;
+    const auto collect = [&](std::string& item) { output.push_back(std::move(item)); };
+
+    CHECK(queue.drain(collect, 0) == 0);
+    CHECK(queue.drain(collect, 3) == 3);
+    CHECK(queue.size() == 5);
+
+    // freed slots are reused by the next lap
+    CHECK(queue.try_push_bulk(input.begin() + 8, input.end()) == 2);
+    CHECK(queue.drain(collect) == 7);
+    CHECK(queue.drain(collect) == 0);
+    CHECK(queue.empty());
+
+    std::vector<std::string> expected(input.begin(), input.begin() + 8);
+    expected.insert(expected.end(), input.begin() + 8, input.end());
+    CHECK(output == expected);
+}
+
+TEST_CASE("MpmcQueue :: Many producers and consumers", "[mpmc-queue]")
+{
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t CONSUMERS = 4;
+    constexpr uint64_t ITEMS_PER_PRODUCER = 50000;
+    constexpr uint64_t BATCH = 16;
+
+    const bool bulk = GENERATE(false, true);
+    auto queue = std::make_unique<MpmcQueue<uint64_t, 256>>();
+
+    // every item is (producer << 32) | sequence number
+    std::vector<std::thread> threads;
+    for (uint64_t producer = 0; producer < PRODUCERS; ++producer)
+    {
+        threads.emplace_back([&, producer]
+        {
+            std::vector<uint64_t> batch(BATCH);
+            for (uint64_t i = 0; i < ITEMS_PER_PRODUCER;)
+            {
+                size_t pushed = 0;
+                if (bulk)
+                {
+                    const auto size = std::min(BATCH, ITEMS_PER_PRODUCER - i);
+                    for (uint64_t j = 0; j < size; ++j)
+                    {
+                        batch[j] = (producer << 32) | (i + j);
+                    }
+                    pushed = queue->try_push_bulk(batch.begin(), batch.begin() + static_cast<ptrdiff_t>(size));
+                }
+                else
+                {
+                    pushed = queue->try_push((producer << 32) | i) ? 1 : 0;
+                }
+
+                if (pushed != 0)
+                {
+                    i += pushed;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::atomic<uint64_t> consumed{0};
+    std::vector<std::vector<uint64_t>> received(CONSUMERS);
+    for (uint64_t consumer = 0; consumer < CONSUMERS; ++consumer)
+    {
+        threads.emplace_back([&, consumer]
+        {
+            uint64_t item = 0;
+            while (consumed.load() < PRODUCERS * ITEMS_PER_PRODUCER)
+            {
+                size_t popped = 0;
+                if (bulk)
+                {
+                    popped = queue->drain([&](uint64_t& value) { received[consumer].push_back(value); }, BATCH);
+                }
+                else if (queue->try_pop(item))
+                {
+                    received[consumer].push_back(item);
+                    popped = 1;
+                }
+
+                if (popped != 0)
+                {
+                    consumed += popped;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // every consumer sees items of a producer in the order they were pushed
+    std::vector<uint64_t> all;
+    bool ordered = true;
+    for (const auto& items : received)
+    {
+        std::vector<uint64_t> last(PRODUCERS, 0);
+        std::vector<bool> seen(PRODUCERS, false);
+        for (const auto item : items)
+        {
+            const auto producer = item >> 32;
+            const auto sequence = item & 0xFFFFFFFF;
+            ordered = ordered && (!seen[producer] || sequence > last[producer]);
+            seen[producer] = true;
+            last[producer] = sequence;
+        }
+        all.insert(all.end(), items.begin(), items.end());
+    }
+
+    CHECK(ordered);
+
+    // nothing is lost or duplicated
+    REQUIRE(all.size() == PRODUCERS * ITEMS_PER_PRODUCER);
+    std::sort(all.begin(), all.end());
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(queue->empty());
+}
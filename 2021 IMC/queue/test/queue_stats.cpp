@@ -0,0 +1,154 @@
+#include <mpmc_queue.hpp>
+#include <queue_stats.hpp>
+#include <spsc_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("QueueStats :: MpmcQueue counters", "[queue-stats]")
+{
+    MpmcQueue<int, 4, BusySpinWait, QueueStats> queue;
+
+    int value = 0;
+    CHECK_FALSE(queue.try_pop(value));
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.try_push(i));
+    }
+    CHECK_FALSE(queue.try_push(4));
+    CHECK(queue.try_pop(value));
+
+    const std::vector<int> batch = {5, 6};
+    CHECK(queue.try_push_bulk(batch.begin(), batch.end()) == 1);
+    CHECK(queue.drain([](int&) {}) == 4);
+
+    const auto snapshot = queue.stats().snapshot();
+    CHECK(snapshot.pushes == 5);
+    CHECK(snapshot.pops == 5);
+    CHECK(snapshot.failedPushes == 1);
+    CHECK(snapshot.failedPops == 1);
+    CHECK(snapshot.pushCasRetries == 0);
+    CHECK(snapshot.popCasRetries == 0);
+    CHECK(snapshot.producerStall.count() == 0);
+    CHECK(snapshot.consumerStall.count() == 0);
+}
+
+TEST_CASE("QueueStats :: SpscQueue counters", "[queue-stats]")
+{
+    SpscQueue<int, 4, BusySpinWait, QueueStats> queue;
+
+    const std::vector<int> input = {0, 1, 2, 3, 4};
+    CHECK(queue.try_push_n(input.begin(), input.size()) == 4);
+    CHECK_FALSE(queue.try_push(4));
+
+    std::vector<int> output(4);
+    CHECK(queue.try_pop_n(output.begin(), 4) == 4);
+
+    int value = 0;
+    CHECK_FALSE(queue.try_pop(value));
+
+    const auto snapshot = queue.stats().snapshot();
+    CHECK(snapshot.pushes == 4);
+    CHECK(snapshot.pops == 4);
+    CHECK(snapshot.failedPushes == 1);
+    CHECK(snapshot.failedPops == 1);
+}
+
+TEST_CASE("QueueStats :: High-water mark", "[queue-stats]")
+{
+    auto queue = std::make_unique<MpmcQueue<uint64_t, 1024, BusySpinWait, QueueStats>>();
+
+    // occupancy is sampled every OCCUPANCY_SAMPLE_PERIOD pushes
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < 512; ++i)
+    {
+        REQUIRE(queue->try_push(i));
+    }
+    for (uint64_t i = 0; i < 512; ++i)
+    {
+        REQUIRE(queue->try_pop(value));
+        REQUIRE(queue->try_push(i));
+    }
+
+    const auto highWaterMark = queue->stats().snapshot().highWaterMark;
+    CHECK(highWaterMark >= 512 - QueueStats::OCCUPANCY_SAMPLE_PERIOD);
+    CHECK(highWaterMark <= 512);
+}
+
+TEST_CASE("QueueStats :: Stall time of blocking operations", "[queue-stats]")
+{
+    constexpr std::chrono::milliseconds DELAY{20};
+
+    MpmcQueue<int, 4, YieldingWait, QueueStats> queue;
+
+    std::thread producer([&]
+    {
+        std::this_thread::sleep_for(DELAY);
+        queue.push(1);
+    });
+
+    int value = 0;
+    queue.pop(value);
+    producer.join();
+
+    const auto snapshot = queue.stats().snapshot();
+    CHECK(value == 1);
+    CHECK(snapshot.consumerStall >= DELAY / 2);
+    CHECK(snapshot.producerStall.count() == 0);
+    CHECK(snapshot.failedPops > 0);
+}
+
+TEST_CASE("QueueStats :: Snapshots from a monitoring thread", "[queue-stats]")
+{
+    constexpr uint64_t PRODUCERS = 2;
+    constexpr uint64_t ITEMS_PER_PRODUCER = 20000;
+
+    auto queue = std::make_unique<MpmcQueue<uint64_t, 64, YieldingWait, QueueStats>>();
+
+    std::vector<std::thread> threads;
+    for (uint64_t p = 0; p < PRODUCERS; ++p)
+    {
+        threads.emplace_back([&]
+        {
+            for (uint64_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+            {
+                queue->push(i);
+            }
+        });
+    }
+    threads.emplace_back([&]
+    {
+        uint64_t value = 0;
+        for (uint64_t i = 0; i < PRODUCERS * ITEMS_PER_PRODUCER; ++i)
+        {
+            queue->pop(value);
+        }
+    });
+
+    // counters only grow
+    bool monotonic = true;
+    QueueStats::Snapshot last;
+    while (last.pops < PRODUCERS * ITEMS_PER_PRODUCER)
+    {
+        const auto snapshot = queue->stats().snapshot();
+        monotonic = monotonic && snapshot.pushes >= last.pushes && snapshot.pops >= last.pops;
+        last = snapshot;
+        std::this_thread::yield();
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(monotonic);
+    const auto snapshot = queue->stats().snapshot();
+    CHECK(snapshot.pushes == PRODUCERS * ITEMS_PER_PRODUCER);
+    CHECK(snapshot.pops == PRODUCERS * ITEMS_PER_PRODUCER);
+    CHECK(snapshot.highWaterMark <= 64);
+}
@@ -0,0 +1,157 @@
+#include <segmented_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SegmentedQueue :: Empty queue", "[segmented-queue]")
+{
+    SegmentedQueue<int, 4> queue;
+
+    int value = 0;
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.try_pop(value));
+    CHECK(queue.empty());
+}
+
+TEST_CASE("SegmentedQueue :: Grows beyond one segment", "[segmented-queue]")
+{
+    SegmentedQueue<std::string, 4> queue;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(queue.try_push(std::to_string(i)));
+    }
+    CHECK_FALSE(queue.empty());
+
+    std::string value;
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(queue.try_pop(value));
+        CHECK(value == std::to_string(i));
+    }
+    CHECK_FALSE(queue.try_pop(value));
+    CHECK(queue.empty());
+}
+
+TEST_CASE("SegmentedQueue :: Consumed segments are recycled", "[segmented-queue]")
+{
+    SegmentedQueue<int, 4> queue;
+
+    int value = 0;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 40; ++i)
+        {
+            REQUIRE(queue.try_push(i));
+        }
+        for (int i = 0; i < 40; ++i)
+        {
+            REQUIRE(queue.try_pop(value));
+            CHECK(value == i);
+        }
+    }
+
+    CHECK(queue.freeSegments() > 0);
+    CHECK(queue.freeSegments() <= SegmentedQueue<int, 4>::MAX_FREE_SEGMENTS);
+}
+
+TEST_CASE("SegmentedQueue :: Move only elements", "[segmented-queue]")
+{
+    SegmentedQueue<std::unique_ptr<int>, 2> queue;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(queue.try_push(std::make_unique<int>(i)));
+    }
+
+    std::unique_ptr<int> value;
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(queue.try_pop(value));
+        REQUIRE(value);
+        CHECK(*value == i);
+    }
+}
+
+TEST_CASE("SegmentedQueue :: Many producers and consumers", "[segmented-queue]")
+{
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t CONSUMERS = 4;
+    constexpr uint64_t ITEMS_PER_PRODUCER = 50000;
+
+    // small segments to go through allocation and reclamation often
+    SegmentedQueue<uint64_t, 32> queue;
+
+    // every item is (producer << 32) | sequence number, pushes never fail
+    std::vector<std::thread> threads;
+    for (uint64_t producer = 0; producer < PRODUCERS; ++producer)
+    {
+        threads.emplace_back([&, producer]
+        {
+            for (uint64_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+            {
+                queue.try_push((producer << 32) | i);
+            }
+        });
+    }
+
+    std::atomic<uint64_t> consumed{0};
+    std::vector<std::vector<uint64_t>> received(CONSUMERS);
+    for (uint64_t consumer = 0; consumer < CONSUMERS; ++consumer)
+    {
+        threads.emplace_back([&, consumer]
+        {
+            uint64_t item = 0;
+            while (consumed.load() < PRODUCERS * ITEMS_PER_PRODUCER)
+            {
+                if (queue.try_pop(item))
+                {
+                    received[consumer].push_back(item);
+                    ++consumed;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // every consumer sees items of a producer in the order they were pushed
+    std::vector<uint64_t> all;
+    bool ordered = true;
+    for (const auto& items : received)
+    {
+        std::vector<uint64_t> last(PRODUCERS, 0);
+        std::vector<bool> seen(PRODUCERS, false);
+        for (const auto item : items)
+        {
+            const auto producer = item >> 32;
+            const auto sequence = item & 0xFFFFFFFF;
+            ordered = ordered && (!seen[producer] || sequence > last[producer]);
+            seen[producer] = true;
+            last[producer] = sequence;
+        }
+        all.insert(all.end(), items.begin(), items.end());
+    }
+
+    CHECK(ordered);
+
+    // nothing is lost or duplicated
+    REQUIRE(all.size() == PRODUCERS * ITEMS_PER_PRODUCER);
+    std::sort(all.begin(), all.end());
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(queue.empty());
+}
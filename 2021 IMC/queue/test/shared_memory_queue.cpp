@@ -0,0 +1,246 @@
+#ifndef _WIN32
+
+#include <shared_memory_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    struct Message
+    {
+        uint64_t sequence;
+        double price;
+        char symbol[8];
+    };
+
+    using Queue = MpmcQueue<Message, 64, ParkingWait>;
+
+    std::string uniqueName(const std::string& test)
+    {
+        return "/imc-queue-test-" + test + "-" + std::to_string(getpid());
+    }
+}
+
+TEST_CASE("SharedMemoryQueue :: Two mappings of one queue", "[shared-memory-queue]")
+{
+    const auto name = uniqueName("mappings");
+    auto producer = SharedMemoryQueue<Queue>::create(name);
+    auto consumer = SharedMemoryQueue<Queue>::open(name);
+
+    // the same object at different addresses
+    CHECK(&producer.queue() != &consumer.queue());
+    CHECK(producer.attached() == 2);
+
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        REQUIRE(producer->try_push(Message{i, 1.5 * static_cast<double>(i), "DVAM1"}));
+    }
+
+    Message message{};
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        REQUIRE(consumer->try_pop(message));
+        CHECK(message.sequence == i);
+        CHECK(message.price == Approx(1.5 * static_cast<double>(i)));
+        CHECK(std::string{message.symbol} == "DVAM1");
+    }
+    CHECK(consumer->empty());
+}
+
+TEST_CASE("SharedMemoryQueue :: Detach", "[shared-memory-queue]")
+{
+    const auto name = uniqueName("detach");
+    auto creator = SharedMemoryQueue<Queue>::create(name);
+    {
+        auto opened = SharedMemoryQueue<Queue>::open(name);
+        CHECK(creator.attached() == 2);
+
+        auto moved = std::move(opened);
+        CHECK(creator.attached() == 2);
+    }
+    CHECK(creator.attached() == 1);
+
+    // the name is removed with the creator
+    creator = SharedMemoryQueue<Queue>::create(uniqueName("detach-other"));
+    CHECK_THROWS_AS(SharedMemoryQueue<Queue>::open(name, std::chrono::milliseconds{10}), std::runtime_error);
+}
+
+TEST_CASE("SharedMemoryQueue :: Open errors", "[shared-memory-queue]")
+{
+    const auto name = uniqueName("errors");
+
+    SECTION("no queue")
+    {
+        CHECK_THROWS_AS(SharedMemoryQueue<Queue>::open(name, std::chrono::milliseconds{10}), std::runtime_error);
+    }
+
+    SECTION("different queue type")
+    {
+        auto creator = SharedMemoryQueue<Queue>::create(name);
+        CHECK_THROWS_AS((SharedMemoryQueue<MpmcQueue<Message, 32, ParkingWait>>::open(name)), std::runtime_error);
+        CHECK_THROWS_AS((SharedMemoryQueue<SpscQueue<Message, 64, ParkingWait>>::open(name)), std::runtime_error);
+    }
+
+    SECTION("creator crashed before initialization")
+    {
+        const auto fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+        REQUIRE(fd != -1);
+        REQUIRE(ftruncate(fd, 1 << 20) == 0);
+        close(fd);
+
+        CHECK_THROWS_AS(SharedMemoryQueue<Queue>::open(name, std::chrono::milliseconds{10}), std::runtime_error);
+
+        // the next creator replaces the stale object
+        auto creator = SharedMemoryQueue<Queue>::create(name);
+        CHECK_NOTHROW(SharedMemoryQueue<Queue>::open(name));
+    }
+}
+
+TEST_CASE("SharedMemoryQueue :: Create errors", "[shared-memory-queue]")
+{
+    const auto name = uniqueName("create");
+
+    SECTION("live queue with the same name")
+    {
+        auto creator = SharedMemoryQueue<Queue>::create(name);
+        auto consumer = SharedMemoryQueue<Queue>::open(name);
+
+        CHECK_THROWS_AS(SharedMemoryQueue<Queue>::create(name), std::runtime_error);
+        CHECK_THROWS_AS((SharedMemoryQueue<SpscQueue<Message, 64, ParkingWait>>::create(name)), std::runtime_error);
+
+        // the existing queue is untouched
+        REQUIRE(creator->try_push(Message{1, 0.0, "DVAM1"}));
+        Message message{};
+        REQUIRE(consumer->try_pop(message));
+        CHECK(message.sequence == 1);
+        CHECK(SharedMemoryQueue<Queue>::open(name).attached() == 3);
+    }
+
+    SECTION("creator process is gone")
+    {
+        const auto child = fork();
+        REQUIRE(child != -1);
+        if (child == 0)
+        {
+            try
+            {
+                // leaves the object behind like a crashed process
+                new SharedMemoryQueue<Queue>{SharedMemoryQueue<Queue>::create(name)};
+            }
+            catch (...)
+            {
+                _exit(1);
+            }
+            _exit(0);
+        }
+
+        int status = 0;
+        REQUIRE(waitpid(child, &status, 0) == child);
+        REQUIRE(WEXITSTATUS(status) == 0);
+
+        auto creator = SharedMemoryQueue<Queue>::create(name);
+        CHECK(creator.attached() == 1);
+    }
+}
+
+TEST_CASE("SharedMemoryQueue :: Concurrent create", "[shared-memory-queue]")
+{
+    constexpr size_t THREADS = 4;
+
+    const auto name = uniqueName("concurrent");
+
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<std::optional<SharedMemoryQueue<Queue>>> creators(THREADS);
+        std::atomic<size_t> waiting{THREADS};
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < THREADS; ++i)
+        {
+            threads.emplace_back([&, i]()
+            {
+                --waiting;
+                while (waiting.load() != 0)
+                {
+                }
+
+                try
+                {
+                    creators[i].emplace(SharedMemoryQueue<Queue>::create(name));
+                }
+                catch (const std::runtime_error&)
+                {
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto isCreated = [](const auto& creator){ return creator.has_value(); };
+        REQUIRE(std::count_if(creators.begin(), creators.end(), isCreated) == 1);
+
+        // the only creator owns the object which is found by the name
+        auto& owner = *std::find_if(creators.begin(), creators.end(), isCreated);
+        auto consumer = SharedMemoryQueue<Queue>::open(name);
+        REQUIRE(owner->queue().try_push(Message{static_cast<uint64_t>(round), 0.0, "DVAM1"}));
+        Message message{};
+        REQUIRE(consumer->try_pop(message));
+        CHECK(message.sequence == static_cast<uint64_t>(round));
+    }
+}
+
+TEST_CASE("SharedMemoryQueue :: Another process", "[shared-memory-queue]")
+{
+    constexpr uint64_t MESSAGES = 10000;
+
+    const auto name = uniqueName("process");
+    auto consumer = SharedMemoryQueue<Queue>::create(name);
+
+    const auto child = fork();
+    REQUIRE(child != -1);
+    if (child == 0)
+    {
+        try
+        {
+            auto producer = SharedMemoryQueue<Queue>::open(name);
+            for (uint64_t i = 0; i < MESSAGES; ++i)
+            {
+                producer->push(Message{i, 0.0, "DVAM1"});
+            }
+        }
+        catch (...)
+        {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    bool ordered = true;
+    Message message{};
+    for (uint64_t i = 0; i < MESSAGES; ++i)
+    {
+        consumer->pop(message);
+        ordered = ordered && message.sequence == i;
+    }
+    CHECK(ordered);
+
+    int status = 0;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+}
+
+#endif
@@ -0,0 +1,162 @@
+#include <spsc_queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscQueue :: Empty queue", "[spsc-queue]")
+{
+    SpscQueue<int, 4> queue;
+
+    int value = 0;
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.try_pop(value));
+    CHECK(queue.capacity() == 4);
+}
+
+TEST_CASE("SpscQueue :: Full queue", "[spsc-queue]")
+{
+    SpscQueue<int, 4> queue;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(queue.try_push(i));
+    }
+    CHECK_FALSE(queue.try_push(4));
+    CHECK(queue.size() == 4);
+
+    int value = 0;
+    CHECK(queue.try_pop(value));
+    CHECK(value == 0);
+    CHECK(queue.try_push(4));
+    CHECK_FALSE(queue.try_push(5));
+}
+
+TEST_CASE("SpscQueue :: FIFO order with wraparound", "[spsc-queue]")
+{
+    SpscQueue<std::string, 8> queue;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            REQUIRE(queue.try_push(std::to_string(round * 5 + i)));
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            std::string value;
+            REQUIRE(queue.try_pop(value));
+            CHECK(value == std::to_string(round * 5 + i));
+        }
+    }
+    CHECK(queue.empty());
+}
+
+TEST_CASE("SpscQueue :: Move only elements", "[spsc-queue]")
+{
+    SpscQueue<std::unique_ptr<int>, 2> queue;
+
+    CHECK(queue.try_push(std::make_unique<int>(42)));
+
+    std::unique_ptr<int> value;
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value);
+    CHECK(*value == 42);
+}
+
+TEST_CASE("SpscQueue :: Bulk operations", "[spsc-queue]")
+{
+    SpscQueue<int, 8> queue;
+    const std::vector<int> input = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    CHECK(queue.try_push_n(input.begin(), 5) == 5);
+    CHECK(queue.try_push_n(input.begin() + 5, 5) == 3);
+    CHECK(queue.try_push_n(input.begin(), 1) == 0);
+
+    std::vector<int> output(10, -1);
+    CHECK(queue.try_pop_n(output.begin(), 6) == 6);
+    CHECK(queue.try_pop_n(output.begin() + 6, 4) == 2);
+    CHECK(queue.try_pop_n(output.begin(), 1) == 0);
+
+    CHECK(std::vector<int>(output.begin(), output.begin() + 8) == std::vector<int>(input.begin(), input.begin() + 8));
+}
+
+TEST_CASE("SpscQueue :: Bulk push and drain", "[spsc-queue]")
+{
+    SpscQueue<std::string, 8> queue;
+    const std::vector<std::string> input = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+
+    CHECK(queue.try_push_bulk(input.begin(), input.begin() + 5) == 5);
+    CHECK(queue.try_push_bulk(input.begin() + 5, input.end()) == 3);
+    CHECK(queue.try_push_bulk(input.begin(), input.end()) == 0);
+
+    std::vector<std::string> output;
+    const auto collect = [&](std::string& item) { output.push_back(std::move(item)); };
+
+    CHECK(queue.drain(collect, 3) == 3);
+    CHECK(queue.size() == 5);
+    CHECK(queue.drain(collect) == 5);
+    CHECK(queue.drain(collect) == 0);
+    CHECK(queue.empty());
+
+    CHECK(output == std::vector<std::string>(input.begin(), input.begin() + 8));
+}
+
+TEST_CASE("SpscQueue :: Two threads", "[spsc-queue]")
+{
+    constexpr uint64_t NUMBER_OF_ITEMS = 1000000;
+    auto queue = std::make_unique<SpscQueue<uint64_t, 1024>>();
+
+    std::thread producer([&]
+    {
+        std::vector<uint64_t> batch;
+        for (uint64_t i = 0; i < NUMBER_OF_ITEMS;)
+        {
+            // mix single and bulk pushes
+            size_t pushed = 0;
+            if (i % 3 == 0)
+            {
+                pushed = queue->try_push(i) ? 1 : 0;
+            }
+            else
+            {
+                batch.clear();
+                for (uint64_t j = i; j < std::min(i + 16, NUMBER_OF_ITEMS); ++j)
+                {
+                    batch.push_back(j);
+                }
+                pushed = queue->try_push_n(batch.begin(), batch.size());
+            }
+
+            if (pushed == 0)
+            {
+                std::this_thread::yield();
+            }
+            i += pushed;
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    std::vector<uint64_t> batch(16);
+    while (expected < NUMBER_OF_ITEMS)
+    {
+        const auto popped = queue->try_pop_n(batch.begin(), batch.size());
+        if (popped == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < popped; ++i)
+        {
+            ordered = ordered && batch[i] == expected++;
+        }
+    }
+
+    producer.join();
+    CHECK(ordered);
+    CHECK(queue->empty());
+}
@@ -0,0 +1,130 @@
+#include <mpmc_queue.hpp>
+#include <spsc_queue.hpp>
+#include <wait_strategy.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WaitStrategy :: Busy spin", "[wait-strategy]")
+{
+    // the queue never gets full, so the test doesn't depend on the number of cores
+    constexpr uint64_t NUMBER_OF_ITEMS = 1000;
+    auto queue = std::make_unique<SpscQueue<uint64_t, 1024, BusySpinWait>>();
+
+    std::thread producer([&]
+    {
+        for (uint64_t i = 0; i < NUMBER_OF_ITEMS; ++i)
+        {
+            queue->push(i);
+        }
+    });
+
+    bool ordered = true;
+    for (uint64_t i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        uint64_t item = 0;
+        queue->pop(item);
+        ordered = ordered && item == i;
+    }
+
+    producer.join();
+    CHECK(ordered);
+}
+
+TEMPLATE_TEST_CASE("WaitStrategy :: Blocking SPSC transfer", "[wait-strategy]", YieldingWait, ParkingWait)
+{
+    constexpr uint64_t NUMBER_OF_ITEMS = 100000;
+    auto queue = std::make_unique<SpscQueue<uint64_t, 16, TestType>>();
+
+    std::thread producer([&]
+    {
+        for (uint64_t i = 0; i < NUMBER_OF_ITEMS; ++i)
+        {
+            queue->push(i);
+        }
+    });
+
+    bool ordered = true;
+    for (uint64_t i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        uint64_t item = 0;
+        queue->pop(item);
+        ordered = ordered && item == i;
+    }
+
+    producer.join();
+    CHECK(ordered);
+    CHECK(queue->empty());
+}
+
+TEMPLATE_TEST_CASE("WaitStrategy :: Blocking MPMC transfer", "[wait-strategy]", YieldingWait, ParkingWait)
+{
+    constexpr uint64_t THREADS = 3;
+    constexpr uint64_t ITEMS_PER_THREAD = 20000;
+    auto queue = std::make_unique<MpmcQueue<uint64_t, 16, TestType>>();
+
+    std::atomic<uint64_t> sum{0};
+    std::vector<std::thread> threads;
+    for (uint64_t i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&]
+        {
+            for (uint64_t j = 1; j <= ITEMS_PER_THREAD; ++j)
+            {
+                queue->push(j);
+            }
+        });
+        threads.emplace_back([&]
+        {
+            uint64_t item = 0;
+            for (uint64_t j = 0; j < ITEMS_PER_THREAD; ++j)
+            {
+                queue->pop(item);
+                sum += item;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(sum == THREADS * ITEMS_PER_THREAD * (ITEMS_PER_THREAD + 1) / 2);
+}
+
+TEST_CASE("WaitStrategy :: Parked consumer is woken up", "[wait-strategy]")
+{
+    auto queue = std::make_unique<SpscQueue<int, 4, ParkingWait>>();
+
+    std::atomic<bool> received{false};
+    std::thread consumer([&]
+    {
+        int item = 0;
+        queue->pop(item);
+        received = item == 42;
+    });
+
+    // give the consumer time to run out of spins and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue->push(42);
+    consumer.join();
+
+    CHECK(received);
+}
+
+TEST_CASE("WaitStrategy :: Notify without waiters", "[wait-strategy]")
+{
+    ParkingWait wait;
+    wait.notify();
+
+    bool ready = false;
+    wait.wait([&]{ return std::exchange(ready, true); });
+    CHECK(ready);
+}
@@ -0,0 +1,147 @@
+#include <work_stealing_deque.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WorkStealingDeque :: Empty deque", "[work-stealing-deque]")
+{
+    WorkStealingDeque<int, 4> deque;
+
+    int value = 0;
+    CHECK(deque.empty());
+    CHECK_FALSE(deque.try_pop(value));
+    CHECK_FALSE(deque.try_steal(value));
+    CHECK(deque.empty());
+}
+
+TEST_CASE("WorkStealingDeque :: Owner pops LIFO, thieves steal FIFO", "[work-stealing-deque]")
+{
+    WorkStealingDeque<int, 8> deque;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(deque.try_push(int{i}));
+    }
+    CHECK(deque.size() == 5);
+
+    int value = 0;
+    CHECK(deque.try_pop(value));
+    CHECK(value == 4);
+    CHECK(deque.try_steal(value));
+    CHECK(value == 0);
+    CHECK(deque.try_steal(value));
+    CHECK(value == 1);
+    CHECK(deque.try_pop(value));
+    CHECK(value == 3);
+    CHECK(deque.try_pop(value));
+    CHECK(value == 2);
+    CHECK_FALSE(deque.try_pop(value));
+    CHECK(deque.empty());
+}
+
+TEST_CASE("WorkStealingDeque :: Full deque", "[work-stealing-deque]")
+{
+    WorkStealingDeque<std::unique_ptr<int>, 4> deque;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(deque.try_push(std::make_unique<int>(i)));
+    }
+
+    auto item = std::make_unique<int>(4);
+    CHECK_FALSE(deque.try_push(std::move(item)));
+    REQUIRE(item);
+
+    std::unique_ptr<int> value;
+    CHECK(deque.try_steal(value));
+    CHECK(*value == 0);
+    CHECK(deque.try_push(std::move(item)));
+    CHECK_FALSE(item);
+
+    for (int i = 4; i > 0; --i)
+    {
+        REQUIRE(deque.try_pop(value));
+        CHECK(*value == i);
+    }
+}
+
+TEST_CASE("WorkStealingDeque :: Owner and thieves", "[work-stealing-deque]")
+{
+    constexpr uint64_t THIEVES = 3;
+    constexpr uint64_t ITEMS = 100000;
+
+    auto deque = std::make_unique<WorkStealingDeque<uint64_t, 64>>();
+    std::atomic<bool> done{false};
+
+    std::vector<std::vector<uint64_t>> stolen(THIEVES);
+    std::vector<std::thread> thieves;
+    for (uint64_t thief = 0; thief < THIEVES; ++thief)
+    {
+        thieves.emplace_back([&, thief]
+        {
+            uint64_t item = 0;
+            while (!done.load() || !deque->empty())
+            {
+                if (deque->try_steal(item))
+                {
+                    stolen[thief].push_back(item);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // the owner pops every third item itself
+    std::vector<uint64_t> all;
+    uint64_t item = 0;
+    for (uint64_t i = 0; i < ITEMS;)
+    {
+        if (deque->try_push(uint64_t{i}))
+        {
+            ++i;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+
+        if (i % 3 == 0 && deque->try_pop(item))
+        {
+            all.push_back(item);
+        }
+    }
+    while (deque->try_pop(item))
+    {
+        all.push_back(item);
+    }
+    done.store(true);
+
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    // a thief sees items in the order they were pushed
+    bool ordered = true;
+    for (const auto& items : stolen)
+    {
+        ordered = ordered && std::is_sorted(items.begin(), items.end());
+        all.insert(all.end(), items.begin(), items.end());
+    }
+    CHECK(ordered);
+
+    // nothing is lost or taken twice
+    REQUIRE(all.size() == ITEMS);
+    std::sort(all.begin(), all.end());
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(deque->empty());
+}
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+set -e
+
+CURRENT_DIR="$(pwd)"
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" >/dev/null 2>&1 && pwd)"
+CMAKE_BUILD_DIR="${SCRIPT_DIR}/build/tsan"
+
+# build everything with ThreadSanitizer, optimized to keep the stress test fast
+mkdir -p "${CMAKE_BUILD_DIR}" && \
+cd "${CMAKE_BUILD_DIR}" && \
+cmake ../../ -DCMAKE_BUILD_TYPE=RELEASE -DSANITIZER=thread && \
+make -j$(nproc)
+
+export TSAN_OPTIONS="halt_on_error=1 second_deadlock_stack=1"
+
+"${CMAKE_BUILD_DIR}/test/unit-tests" --order rand
+"${CMAKE_BUILD_DIR}/stress/queue-stress" --items 20000 --rounds 2
+
+cd "${CURRENT_DIR}"